@@ -0,0 +1,34 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>  // For size_t
+
+#define ARENA_ALIGN 64              // Every allocation starts on a cache line
+#define ARENA_DEFAULT_BLOCK (1 << 20)  // First block when arena_create is given 0
+
+/**
+ * @brief Bump allocator for scratch and result buffers that live until the next reset.
+ *
+ * Allocation is a pointer bump in the current block; individual frees are no-ops except for
+ * the most recent allocation, which is rolled back. When a block runs out a bigger one is
+ * chained on, and arena_reset merges the chain into a single block, so a caller that resets
+ * between jobs of similar size stops touching the heap after the first job.
+ *
+ * Functions that take an arena accept NULL and then use malloc/realloc/free as before; their
+ * results must be freed the usual way. With an arena, results live in the arena and are
+ * released by arena_reset or arena_destroy (do not pass them to free_points). An arena is not
+ * thread-safe: use one per thread.
+ */
+typedef struct Arena Arena;
+
+// Arena Functions (declared in arena.c)
+Arena* arena_create(size_t capacity);  // Bytes in the first block (0: ARENA_DEFAULT_BLOCK)
+void arena_destroy(Arena* arena);  // NULL is a no-op
+void* arena_alloc(Arena* arena, size_t bytes);  // NULL arena: malloc
+void* arena_resize(Arena* arena, void* ptr, size_t old_bytes, size_t new_bytes);  // NULL arena: realloc; grows the last allocation in place
+void arena_free(Arena* arena, void* ptr);  // NULL arena: free; otherwise only rolls back the last allocation
+void arena_reset(Arena* arena);  // Releases every allocation at once, keeping the memory
+size_t arena_used(const Arena* arena);  // Bytes handed out since the last reset
+size_t arena_capacity(const Arena* arena);  // Bytes owned by the arena
+
+#endif /* ARENA_H */
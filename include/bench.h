@@ -0,0 +1,68 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "geometry.h"  // For PointSet, AccumMode, ThreadPool
+#include <stdio.h>     // For FILE
+
+#define BENCH_MAX_SIZES 16  // Point counts per run
+
+/**
+ * @brief Synthetic point distributions for the benchmark.
+ */
+typedef enum {
+    BENCH_UNIFORM = 0,    /**< Uniform in a square: hull grows like log n */
+    BENCH_CIRCLE = 1,     /**< Uniform in a disk: hull grows like n^(1/3) */
+    BENCH_GAUSSIAN = 2,   /**< Normal around the centre: very small hull */
+    BENCH_CLUSTERED = 3,  /**< Tight clusters around random centres, like survey setups */
+    BENCH_ON_HULL = 4,    /**< On a circle in random order: every point is a hull candidate */
+    BENCH_DIST_COUNT
+} BenchDistribution;
+
+/**
+ * @brief Report format.
+ */
+typedef enum {
+    BENCH_TEXT = 0,  /**< Human-readable table, followed by the kernel benchmarks */
+    BENCH_JSON = 1,  /**< One JSON document */
+    BENCH_CSV = 2    /**< One row per case and phase */
+} BenchFormat;
+
+/**
+ * @brief Benchmark settings (fill with bench_default_config, then override).
+ */
+typedef struct {
+    size_t sizes[BENCH_MAX_SIZES];  /**< Point counts to run */
+    size_t size_count;
+    unsigned distributions;         /**< Bit mask of 1 << BenchDistribution */
+    int reps;                       /**< Timed repetitions per case */
+    int warmup;                     /**< Untimed repetitions before them */
+    BenchFormat format;
+    const char* algo;               /**< "graham", "monotone", "parallel" or "chan" */
+    double grid;                    /**< Grid step for the integer hull (0: float hull) */
+    int cull;                       /**< Run the culling pre-pass */
+    int is_3d;                      /**< Generate z as well */
+    AccumMode accum;                /**< Metric accumulation */
+    ThreadPool* pool;               /**< Loader and hull threads (may be NULL) */
+} BenchConfig;
+
+/**
+ * @brief Order statistics of a set of timings.
+ */
+typedef struct {
+    double min;
+    double median;
+    double p95;   /**< Nearest-rank 95th percentile */
+    double mean;
+} BenchSummary;
+
+// Benchmark Functions (declared in bench.c)
+void bench_default_config(BenchConfig* config);
+int bench_parse_sizes(const char* list, BenchConfig* config);  // "1000,1e6"; 0 or -1
+int bench_parse_distributions(const char* list, unsigned* mask);  // Names or "all"; 0 or -1
+const char* bench_distribution_name(BenchDistribution dist);
+PointSet* bench_generate_points(BenchDistribution dist, size_t count, int is_3d, unsigned long seed);  // Deterministic
+void bench_summarize(double* samples, size_t count, BenchSummary* summary);  // Sorts samples
+int bench_run(const BenchConfig* config, FILE* out);  // 0, or -1 if a case failed
+void bench_kernels(size_t count, int is_3d, int reps, FILE* out);  // Layout, SIMD and accumulation kernels
+
+#endif /* BENCH_H */
@@ -0,0 +1,44 @@
+#ifndef CULL_H
+#define CULL_H
+
+#include <stddef.h>  // For size_t
+#include <float.h>   // For FLT_EPSILON
+#include <math.h>    // For fabsf
+
+#define CULL_EDGES 8  // Akl-Toussaint octagon: extremes in x, y, x+y and x-y
+
+/**
+ * @brief Edges of the Akl-Toussaint octagon, padded to CULL_EDGES by repeating edges.
+ *
+ * Shared by the AoS and SoA culls, which read coordinates through find_cull_octagon's
+ * stride, so both layouts keep exactly the same points.
+ */
+typedef struct {
+    float ox[CULL_EDGES];  /**< Edge origins */
+    float oy[CULL_EDGES];
+    float dx[CULL_EDGES];  /**< Edge directions */
+    float dy[CULL_EDGES];
+} CullOctagon;
+
+// Cull Functions (declared in geometry.c)
+size_t find_cull_octagon(const float* x, const float* y, size_t stride, size_t n,
+                         CullOctagon* octagon);  // stride in floats; corners after dropping repeats (< 3: degenerate)
+
+/**
+ * @brief Tests whether (x, y) is strictly inside the octagon, branch-free.
+ *
+ * Each edge only counts the point as inside when the float orientation exceeds its
+ * (3 + 16eps) * eps rounding error bound, so hull vertices are never culled.
+ */
+static inline int cull_octagon_inside(const CullOctagon* octagon, float x, float y) {
+    const float err = 2.0f * FLT_EPSILON;
+    int inside = 1;
+    for (size_t k = 0; k < CULL_EDGES; ++k) {
+        float left = octagon->dx[k] * (y - octagon->oy[k]);
+        float right = octagon->dy[k] * (x - octagon->ox[k]);
+        inside &= (left - right) > err * (fabsf(left) + fabsf(right));
+    }
+    return inside;
+}
+
+#endif /* CULL_H */
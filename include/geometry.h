@@ -1,38 +1,112 @@
-#ifndef GEOMETRY_H
-#define GEOMETRY_H
-
-#include <stddef.h>  // For size_t
-
-/**
- * @brief Structure representing a 2D/3D point.
- */
-typedef struct {
-    float x;  /**< X-coordinate */
-    float y;  /**< Y-coordinate */
-    float z;  /**< Z-coordinate (ignored in 2D mode) */
-} Point;
-
-/**
- * @brief Structure representing a set of points (dynamic array).
- */
-typedef struct {
-    Point* points;  /**< Dynamic array of points */
-    size_t count;   /**< Number of points in the set */
-    int is_3d;      /**< Flag: 1 if 3D points, 0 if 2D */
-} PointSet;
-
-// IO Functions (declared in io.c)
-PointSet* load_points(const char* filename);
-int save_points(const PointSet* set, const char* filename);
-void free_points(PointSet* set);
-
-// Geometry Functions (declared in geometry.c)
-PointSet* compute_convex_hull(const PointSet* set, int num_threads);  // Updated: added num_threads param
-float compute_distance(const Point* a, const Point* b);
-float compute_area(const PointSet* hull);  // Shoelace formula for 2D hull
-float compute_path_length(const PointSet* hull);
-
-// Utility Functions
-int is_collinear(const Point* a, const Point* b, const Point* c);  // Helper for hull
-
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For uint32_t
+#include "thread_pool.h"  // For ThreadPool
+#include "arena.h"        // For Arena
+
+/**
+ * @brief Structure representing a 2D/3D point.
+ */
+typedef struct {
+    float x;  /**< X-coordinate */
+    float y;  /**< Y-coordinate */
+    float z;  /**< Z-coordinate (ignored in 2D mode) */
+} Point;
+
+/**
+ * @brief Compact 2D point (8 bytes) used by the hulls for sets without z.
+ *
+ * x and y sit at the same offsets as in Point, so code that only reads x and y handles
+ * both layouts through the element size.
+ */
+typedef struct {
+    float x;  /**< X-coordinate */
+    float y;  /**< Y-coordinate */
+} Point2;
+
+/**
+ * @brief Structure representing a set of points (dynamic array).
+ */
+typedef struct {
+    Point* points;  /**< Dynamic array of points */
+    size_t count;   /**< Number of points in the set */
+    int is_3d;      /**< Flag: 1 if 3D points, 0 if 2D */
+} PointSet;
+
+/**
+ * @brief Convex hull given as row indices into the input PointSet.
+ */
+typedef struct {
+    uint32_t* indices;  /**< Hull vertices as indices into the input, counterclockwise */
+    size_t count;       /**< Number of hull vertices */
+} HullIndices;
+
+/**
+ * @brief Triangle mesh produced by the 3D convex hull.
+ */
+typedef struct {
+    Point* vertices;      /**< Hull vertices */
+    size_t vertex_count;  /**< Number of vertices */
+    size_t* faces;        /**< 3 vertex indices per triangle, counterclockwise seen from outside */
+    size_t face_count;    /**< Number of triangles */
+} HullMesh;
+
+/**
+ * @brief Accumulation used for area and perimeter sums.
+ */
+typedef enum {
+    ACCUM_FLOAT = 0,    /**< Float products and sums (fastest, legacy results) */
+    ACCUM_DOUBLE = 1,   /**< Exact float products in double, double sums */
+    ACCUM_KAHAN = 2,    /**< Double terms with Kahan-compensated sums */
+    ACCUM_PAIRWISE = 3  /**< Double terms with blocked pairwise sums */
+} AccumMode;
+
+/**
+ * @brief Incremental point reader for bounded-memory processing (opaque, defined in io.c).
+ */
+typedef struct PointReader PointReader;
+
+// IO Functions (declared in io.c)
+PointSet* load_points(const char* filename);
+PointSet* load_points_mmap(const char* filename, ThreadPool* pool);  // Zero-copy mmap parser, line ranges on the pool
+int load_points_into(const char* filename, PointSet* set, size_t* capacity, ThreadPool* pool);  // Reuses set->points across files
+PointSet* load_points_arena(const char* filename, Arena* arena);  // Result lives in arena (NULL: heap)
+int save_points(const PointSet* set, const char* filename, int precision);  // precision: decimals (2 = legacy)
+void free_points(PointSet* set);
+PointReader* point_reader_open(const char* filename);  // CSV, OBJ or .igcb, read block by block
+size_t point_reader_read(PointReader* reader, Point* out, size_t max_points);  // 0 at end of input
+int point_reader_is_3d(const PointReader* reader);  // 3D flag for the points read so far
+int point_reader_failed(const PointReader* reader);  // Non-zero after a read error
+void point_reader_close(PointReader* reader);
+int save_mesh(const HullMesh* mesh, const char* filename, int precision);  // OBJ with faces, else vertices only
+void free_mesh(HullMesh* mesh);
+
+// Geometry Functions (declared in geometry.c)
+PointSet* compute_convex_hull(const PointSet* set, ThreadPool* pool, Arena* arena);  // NULL pool: serial; NULL arena: heap
+PointSet* compute_convex_hull_monotone(const PointSet* set, ThreadPool* pool, Arena* arena);  // Reentrant, no pivot state
+PointSet* compute_convex_hull_parallel(const PointSet* set, ThreadPool* pool, Arena* arena);  // Hull of per-thread hulls
+PointSet* compute_convex_hull_chan(const PointSet* set, ThreadPool* pool, Arena* arena);  // Output-sensitive, O(n log h)
+HullIndices* compute_convex_hull_indices(const PointSet* set, ThreadPool* pool, Arena* arena);  // Sorts 4-byte indices
+void free_hull_indices(HullIndices* hull);  // Heap results only
+size_t convex_hull_scratch_bytes(size_t count, int is_3d);  // Scratch for compute_convex_hull_into
+long compute_convex_hull_into(const PointSet* set, void* scratch, size_t scratch_bytes, Point* out,
+                              size_t capacity);  // No allocation; returns the hull size (snprintf-style) or -1
+PointSet* cull_interior_points(const PointSet* set, Arena* arena);  // Akl-Toussaint pre-pass before hull sorting
+PointSet* compute_convex_hull_stream(PointReader* reader, size_t block_size, ThreadPool* pool, size_t* total_points);
+float compute_distance(const Point* a, const Point* b);
+float compute_area(const PointSet* hull);  // Shoelace formula for 2D hull
+float compute_path_length(const PointSet* hull);
+double compute_area_accum(const PointSet* hull, AccumMode mode);  // -1 on invalid input
+double compute_path_length_accum(const PointSet* hull, AccumMode mode);
+
+// 3D Hull Functions (declared in hull3d.c)
+HullMesh* compute_convex_hull_3d(const PointSet* set, ThreadPool* pool);  // Quickhull, parallel point assignment
+float compute_surface_area(const HullMesh* mesh);
+float compute_volume(const HullMesh* mesh);
+
+// Utility Functions
+int is_collinear(const Point* a, const Point* b, const Point* c);  // Helper for hull
+
 #endif /* GEOMETRY_H */
\ No newline at end of file
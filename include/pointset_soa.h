@@ -0,0 +1,34 @@
+#ifndef POINTSET_SOA_H
+#define POINTSET_SOA_H
+
+#include "geometry.h"  // For Point, PointSet
+
+#define SOA_ALIGNMENT 64  // Coordinate arrays start on a cache line
+
+/**
+ * @brief Structure-of-arrays point set: one aligned array per coordinate.
+ *
+ * 2D sets carry no z array, so scans touch only the bytes they use and consecutive
+ * coordinates load straight into vector registers.
+ */
+typedef struct {
+    float* x;      /**< X-coordinates (SOA_ALIGNMENT-aligned) */
+    float* y;      /**< Y-coordinates (SOA_ALIGNMENT-aligned) */
+    float* z;      /**< Z-coordinates, or NULL for 2D sets */
+    size_t count;  /**< Number of points in the set */
+    int is_3d;     /**< Flag: 1 if 3D points, 0 if 2D */
+} PointSetSoA;
+
+// SoA Functions (declared in soa.c)
+PointSetSoA* create_points_soa(size_t count, int is_3d);  // Uninitialized coordinates
+PointSetSoA* points_to_soa(const PointSet* set);
+PointSet* soa_to_points(const PointSetSoA* soa);  // z = 0 for 2D sets
+void free_points_soa(PointSetSoA* soa);
+size_t find_pivot_soa(const PointSetSoA* soa);  // Index of lowest y (then lowest x)
+PointSetSoA* cull_interior_points_soa(const PointSetSoA* soa);  // Same survivors as cull_interior_points
+float compute_area_soa(const PointSetSoA* hull);
+float compute_path_length_soa(const PointSetSoA* hull);
+double compute_area_soa_accum(const PointSetSoA* hull, AccumMode mode);
+double compute_path_length_soa_accum(const PointSetSoA* hull, AccumMode mode);
+
+#endif /* POINTSET_SOA_H */
@@ -0,0 +1,12 @@
+#ifndef PREDICATES_H
+#define PREDICATES_H
+
+#include "geometry.h"  // For Point
+
+// Predicate Functions (declared in predicates.c)
+double orient2d(const Point* a, const Point* b, const Point* c);  // > 0 if a, b, c turn counterclockwise; exact sign
+double orient2d_xy(float ax, float ay, float bx, float by, float cx, float cy);  // Same, for any point layout
+double orient2d_fast(const Point* a, const Point* b, const Point* c);  // Unfiltered double estimate
+unsigned long orient2d_exact_calls(void);  // Times the filter failed and the adaptive stages ran
+
+#endif /* PREDICATES_H */
@@ -0,0 +1,39 @@
+#ifndef QUANTIZE_H
+#define QUANTIZE_H
+
+#include "geometry.h"  // For PointSet, Arena
+#include <stdint.h>    // For uint64_t, int64_t
+
+#define QUANT_NARROW_CELLS (1LL << 31)  // Extent below which a point packs into one word
+#define QUANT_WIDE_CELLS (1LL << 62)    // Largest extent the grid accepts
+
+/**
+ * @brief Point set snapped to a square grid, stored as non-negative integer cell offsets.
+ *
+ * Each coordinate is rounded to the nearest multiple of step and stored relative to the
+ * lowest cell in x and in y. When both extents are below 2^31 cells a point is one word,
+ * x << 32 | y, so comparing words compares (x, y) and orientation is exact in int64.
+ * Otherwise a point is two words, x then y, with exact 128-bit orientation. 3D sets append
+ * a word holding z's float bits, which the hull carries along untouched.
+ */
+typedef struct {
+    uint64_t* words;   /**< count * stride words */
+    size_t count;      /**< Number of points */
+    size_t stride;     /**< Words per point: key_words, plus one for z in 3D */
+    size_t key_words;  /**< 1 (32-bit cells) or 2 (64-bit cells) */
+    int64_t origin_x;  /**< Grid cell of offset 0 in x */
+    int64_t origin_y;  /**< Grid cell of offset 0 in y */
+    double step;       /**< Grid spacing in input units */
+    int is_3d;         /**< Flag: 1 if a z word follows the key */
+} QuantizedSet;
+
+// Quantization Functions (declared in quantize.c)
+QuantizedSet* quantize_points(const PointSet* set, double step, Arena* arena);  // NULL if step is too fine for the extent
+PointSet* dequantize_points(const QuantizedSet* q, Arena* arena);  // Cell centres back to float
+void free_quantized(QuantizedSet* q);  // Heap sets only
+void radix_sort_words(uint64_t* elems, uint64_t* scratch, size_t n, size_t stride, size_t key_words,
+                      ThreadPool* pool, Arena* arena);  // Stable, ascending; NULL pool: serial; NULL arena: heap
+QuantizedSet* compute_convex_hull_quantized(QuantizedSet* q, Arena* arena);  // Sorts q in place; exact integer monotone chain
+PointSet* compute_convex_hull_grid(const PointSet* set, double step, Arena* arena);  // Quantize, hull, dequantize
+
+#endif /* QUANTIZE_H */
@@ -0,0 +1,30 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include "geometry.h"  // For Point
+
+/**
+ * @brief Instruction set used by the metric kernels.
+ */
+typedef enum {
+    SIMD_SCALAR = 0,  /**< Portable C loop */
+    SIMD_SSE = 1,     /**< 4 edges per step (SSE2) */
+    SIMD_AVX2 = 2     /**< 8 edges per step (AVX2) */
+} SimdLevel;
+
+// SIMD Functions (declared in simd.c)
+SimdLevel simd_detect_level(void);  // Best level this CPU supports
+SimdLevel simd_set_level(SimdLevel level);  // Clamped to the detected level; not thread-safe
+SimdLevel simd_get_level(void);
+const char* simd_level_name(SimdLevel level);
+float simd_shoelace_aos(const Point* points, size_t n);  // Twice the signed area, closing edge included
+float simd_shoelace_soa(const float* x, const float* y, size_t n);
+float simd_path_length_aos(const Point* points, size_t n);  // Closed path length
+float simd_path_length_soa(const float* x, const float* y, const float* z, size_t n);  // z may be NULL
+
+double simd_shoelace_accum_aos(const Point* points, size_t n, AccumMode mode);  // Double-precision modes
+double simd_shoelace_accum_soa(const float* x, const float* y, size_t n, AccumMode mode);
+double simd_path_length_accum_aos(const Point* points, size_t n, AccumMode mode);
+double simd_path_length_accum_soa(const float* x, const float* y, const float* z, size_t n, AccumMode mode);
+
+#endif /* SIMD_H */
@@ -0,0 +1,49 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdint.h>  // For uint64_t
+#include <stdio.h>   // For FILE, size_t
+
+/**
+ * @brief Pipeline phases timed by the instrumentation layer.
+ */
+typedef enum {
+    STATS_PHASE_LOAD = 0,     /**< Reading and parsing input */
+    STATS_PHASE_CULL = 1,     /**< Akl-Toussaint interior culling */
+    STATS_PHASE_SORT = 2,     /**< Hull input copy or quantization, pivot search and sort */
+    STATS_PHASE_SCAN = 3,     /**< Hull scan over the sorted points, dequantization */
+    STATS_PHASE_METRICS = 4,  /**< Area and perimeter */
+    STATS_PHASE_WRITE = 5,    /**< Formatting and writing output */
+    STATS_PHASE_COUNT
+} StatsPhase;
+
+/**
+ * @brief Event counters kept by the instrumentation layer.
+ */
+typedef enum {
+    STATS_POINTS_PARSED = 0,  /**< Points accepted by the loaders */
+    STATS_LINES_SKIPPED = 1,  /**< Text lines with fewer than two fields */
+    STATS_POINTS_CULLED = 2,  /**< Points discarded by the culling pre-pass */
+    STATS_COMPARISONS = 3,    /**< Comparator calls in the hull sorts */
+    STATS_HULL_POPS = 4,      /**< Points popped off the hull stack by the scans */
+    STATS_BYTES_WRITTEN = 5,  /**< Bytes written by save_points and save_mesh */
+    STATS_ALLOCATIONS = 6,    /**< Heap calls for point buffers and arena blocks (see arena.h) */
+    STATS_COUNTER_COUNT
+} StatsCounter;
+
+// Stats Functions (declared in stats.c)
+double stats_now_ms(void);  // Monotonic wall clock
+void stats_enable(int on);  // Timers and counters are off (and free) until enabled
+int stats_enabled(void);
+void stats_reset(void);  // Clears phases and counters
+double stats_phase_begin(void);  // Start stamp for stats_phase_end (0 while disabled)
+void stats_phase_end(StatsPhase phase, double start);  // Adds the elapsed time; thread-safe
+double stats_phase_ms(StatsPhase phase);  // Total time recorded since the last reset
+const char* stats_phase_name(StatsPhase phase);
+void stats_add(StatsCounter counter, uint64_t amount);  // No-op while disabled; thread-safe
+uint64_t stats_counter(StatsCounter counter);
+const char* stats_counter_name(StatsCounter counter);
+size_t stats_peak_rss_kb(void);  // High-water resident set size of the process
+void stats_write_json(FILE* out, double total_ms);  // Phases, total and counters as one JSON object
+
+#endif /* STATS_H */
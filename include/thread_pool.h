@@ -0,0 +1,27 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stddef.h>  // For size_t
+
+#define THREAD_POOL_INLINE_ITEMS 4096  // Default: calls on fewer items run on the caller alone
+
+/**
+ * @brief Persistent worker threads with one work-stealing task queue per worker.
+ *
+ * Created once and passed to the hull routines; a NULL pool means "run serially on the caller".
+ * The thread that submits tasks runs them too while it waits, so a pool created for N threads
+ * starts N - 1 workers.
+ */
+typedef struct ThreadPool ThreadPool;
+
+typedef void (*ThreadPoolTask)(void* arg);  // Task body; receives one element of the args array
+
+// Thread Pool Functions (declared in thread_pool.c)
+ThreadPool* thread_pool_create(int num_threads);  // Caller included; 1 starts no workers
+void thread_pool_destroy(ThreadPool* pool);  // Waits for queued tasks (NULL is a no-op)
+size_t thread_pool_size(const ThreadPool* pool);  // Threads that run tasks, caller included; 1 for NULL
+void thread_pool_set_inline_threshold(ThreadPool* pool, size_t items);  // 0 never inlines
+size_t thread_pool_parallelism(const ThreadPool* pool, size_t items);  // Chunks worth splitting items into
+void thread_pool_run(ThreadPool* pool, ThreadPoolTask fn, void* args, size_t arg_size, size_t count);  // Blocks until all count tasks ran
+
+#endif /* THREAD_POOL_H */
@@ -0,0 +1,209 @@
+#define _POSIX_C_SOURCE 200112L  // For posix_memalign
+
+#include "arena.h"
+#include "stats.h"
+#include <stdlib.h>  // For posix_memalign, malloc, realloc, free
+#include <stdio.h>   // For fprintf, stderr
+#include <string.h>  // For memcpy
+
+// Block header; the usable bytes follow it at the next ARENA_ALIGN boundary
+typedef struct ArenaBlock {
+    struct ArenaBlock* prev;  // Older, smaller block (NULL for the first)
+    size_t size;              // Usable bytes
+    size_t used;
+} ArenaBlock;
+
+#define BLOCK_HEADER ((sizeof(ArenaBlock) + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN)
+
+struct Arena {
+    ArenaBlock* block;  // Current block; older ones are chained through prev
+    size_t used;        // Bytes handed out since the last reset, padding included
+    size_t capacity;    // Usable bytes in all blocks
+    void* last;         // Most recent allocation: the only one that can grow in place or roll back
+};
+
+// Helper: Rounds a request up to whole alignment units (at least one)
+static size_t round_up(size_t bytes) {
+    if (bytes == 0) bytes = 1;
+    return (bytes + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+}
+
+// Helper: Usable bytes of a block
+static unsigned char* block_data(ArenaBlock* block) {
+    return (unsigned char*)block + BLOCK_HEADER;
+}
+
+// Helper: Allocates an empty block chained after prev; NULL on failure
+static ArenaBlock* block_new(size_t size, ArenaBlock* prev) {
+    void* memory;
+    if (posix_memalign(&memory, ARENA_ALIGN, BLOCK_HEADER + size) != 0) return NULL;
+    stats_add(STATS_ALLOCATIONS, 1);
+    ArenaBlock* block = (ArenaBlock*)memory;
+    block->prev = prev;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+// Helper: Frees a block and every older block
+static void block_free_chain(ArenaBlock* block) {
+    while (block) {
+        ArenaBlock* prev = block->prev;
+        free(block);
+        block = prev;
+    }
+}
+
+/**
+ * @brief Creates an arena with one block.
+ * @param capacity Usable bytes in the first block (0 selects ARENA_DEFAULT_BLOCK).
+ * @return New arena, or NULL on allocation failure.
+ */
+Arena* arena_create(size_t capacity) {
+    Arena* arena = malloc(sizeof(Arena));
+    if (!arena) {
+        fprintf(stderr, "Memory allocation failed for arena\n");
+        return NULL;
+    }
+    capacity = round_up(capacity > 0 ? capacity : ARENA_DEFAULT_BLOCK);
+    arena->block = block_new(capacity, NULL);
+    if (!arena->block) {
+        free(arena);
+        fprintf(stderr, "Memory allocation failed for arena\n");
+        return NULL;
+    }
+    arena->used = 0;
+    arena->capacity = capacity;
+    arena->last = NULL;
+    return arena;
+}
+
+/**
+ * @brief Frees the arena and everything allocated from it.
+ * @param arena Arena to destroy (NULL is ignored).
+ */
+void arena_destroy(Arena* arena) {
+    if (arena) {
+        block_free_chain(arena->block);
+        free(arena);
+    }
+}
+
+/**
+ * @brief Allocates ARENA_ALIGN-aligned memory that stays valid until the next reset.
+ *
+ * When the current block is full, a block of twice its size (or the request, if larger) is
+ * chained on; the rest of the old block is not reused before the next reset.
+ * @param arena Arena to allocate from, or NULL for malloc.
+ * @param bytes Size of the allocation.
+ * @return Pointer to the memory, or NULL on allocation failure.
+ */
+void* arena_alloc(Arena* arena, size_t bytes) {
+    if (!arena) {
+        stats_add(STATS_ALLOCATIONS, 1);
+        return malloc(bytes > 0 ? bytes : 1);
+    }
+    size_t need = round_up(bytes);
+    ArenaBlock* block = arena->block;
+    if (block->size - block->used < need) {
+        size_t size = block->size * 2 > need ? block->size * 2 : need;
+        ArenaBlock* grown = block_new(size, block);
+        if (!grown) return NULL;
+        arena->block = block = grown;
+        arena->capacity += size;
+    }
+    void* ptr = block_data(block) + block->used;
+    block->used += need;
+    arena->used += need;
+    arena->last = ptr;
+    return ptr;
+}
+
+/**
+ * @brief Changes the size of an allocation, like realloc.
+ *
+ * The most recent allocation grows or shrinks in place while the current block has room,
+ * which makes a buffer that is filled last and grown by doubling as cheap as one sized up
+ * front. Other allocations keep their address when shrinking and are copied when growing.
+ * @param arena Arena the allocation came from, or NULL for realloc.
+ * @param ptr Allocation to resize (NULL allocates).
+ * @param old_bytes Its current size (ignored without an arena).
+ * @param new_bytes Requested size.
+ * @return Pointer to the resized memory, or NULL on failure (ptr stays valid).
+ */
+void* arena_resize(Arena* arena, void* ptr, size_t old_bytes, size_t new_bytes) {
+    if (!arena) {
+        stats_add(STATS_ALLOCATIONS, 1);
+        return realloc(ptr, new_bytes > 0 ? new_bytes : 1);
+    }
+    if (!ptr) return arena_alloc(arena, new_bytes);
+    if (ptr == arena->last) {
+        ArenaBlock* block = arena->block;
+        size_t offset = (size_t)((unsigned char*)ptr - block_data(block));
+        size_t need = round_up(new_bytes);
+        if (need <= block->size - offset) {
+            arena->used = arena->used - (block->used - offset) + need;
+            block->used = offset + need;
+            return ptr;
+        }
+    } else if (new_bytes <= old_bytes) {
+        return ptr;
+    }
+    void* moved = arena_alloc(arena, new_bytes);
+    if (moved) memcpy(moved, ptr, old_bytes < new_bytes ? old_bytes : new_bytes);
+    return moved;
+}
+
+/**
+ * @brief Releases an allocation.
+ * @param arena Arena the allocation came from, or NULL for free.
+ * @param ptr Allocation to release; inside an arena only the most recent one is given back.
+ */
+void arena_free(Arena* arena, void* ptr) {
+    if (!arena) {
+        free(ptr);
+        return;
+    }
+    if (ptr && ptr == arena->last) {
+        ArenaBlock* block = arena->block;
+        size_t offset = (size_t)((unsigned char*)ptr - block_data(block));
+        arena->used -= block->used - offset;
+        block->used = offset;
+        arena->last = NULL;
+    }
+}
+
+/**
+ * @brief Releases every allocation at once.
+ *
+ * If the last cycle needed more than one block, the chain is replaced by a single block of
+ * the combined size, so the next cycle of the same size allocates nothing.
+ * @param arena Arena to reset (NULL is ignored).
+ */
+void arena_reset(Arena* arena) {
+    if (!arena) return;
+    if (arena->block->prev) {
+        ArenaBlock* merged = block_new(arena->capacity, NULL);
+        if (merged) {
+            block_free_chain(arena->block);
+            arena->block = merged;
+        }
+    }
+    arena->block->used = 0;
+    arena->used = 0;
+    arena->last = NULL;
+}
+
+/**
+ * @brief Bytes handed out since the last reset, alignment padding included.
+ */
+size_t arena_used(const Arena* arena) {
+    return arena ? arena->used : 0;
+}
+
+/**
+ * @brief Bytes owned by the arena across all of its blocks.
+ */
+size_t arena_capacity(const Arena* arena) {
+    return arena ? arena->capacity : 0;
+}
@@ -0,0 +1,567 @@
+#define _POSIX_C_SOURCE 200809L  // For mkstemp
+
+#include "bench.h"
+#include "pointset_soa.h"
+#include "simd.h"
+#include "stats.h"
+#include "quantize.h"
+#include <stdlib.h>  // For malloc, qsort, strtod, mkstemp
+#include <string.h>  // For strcmp, strchr
+#include <math.h>    // For sqrt, log, cos, sin and long double reference sums
+#include <unistd.h>  // For close, unlink
+
+#define BENCH_PI 3.14159265358979323846
+#define BENCH_SCALE 100.0      // Points fill [0, BENCH_SCALE) in x and y
+#define BENCH_CLUSTERS 16      // Centres for the clustered distribution
+#define BENCH_PRECISION 4      // Decimals in the temporary CSV used for load timings
+#define BENCH_PHASES STATS_PHASE_WRITE  // Phases of a timed pass (it writes no output)
+#define BENCH_COLUMNS (BENCH_PHASES + 1)  // Phases plus the total
+
+static const char* DIST_NAMES[BENCH_DIST_COUNT] = {"uniform", "circle", "gaussian", "clustered", "hull"};
+
+// Helper: splitmix64 step; small, fast and identical on every platform (unlike rand)
+static unsigned long long next_random(unsigned long long* state) {
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Helper: Uniform double in [0, 1)
+static double random_unit(unsigned long long* state) {
+    return (double)(next_random(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Helper: Standard normal sample (Box-Muller, one of the pair)
+static double random_normal(unsigned long long* state) {
+    double u = random_unit(state);
+    double v = random_unit(state);
+    return sqrt(-2.0 * log(1.0 - u)) * cos(2.0 * BENCH_PI * v);
+}
+
+/**
+ * @brief Fills a BenchConfig with the defaults used by --benchmark.
+ * @param config Config to fill.
+ */
+void bench_default_config(BenchConfig* config) {
+    memset(config, 0, sizeof(*config));
+    config->sizes[0] = 1000;
+    config->sizes[1] = 10000;
+    config->sizes[2] = 100000;
+    config->size_count = 3;
+    config->distributions = (1u << BENCH_DIST_COUNT) - 1;
+    config->reps = 10;
+    config->warmup = 1;
+    config->format = BENCH_TEXT;
+    config->algo = "graham";
+    config->accum = ACCUM_FLOAT;
+}
+
+/**
+ * @brief Parses a comma-separated list of point counts (e.g. "1000,1e6").
+ * @param list The list.
+ * @param config Receives sizes and size_count.
+ * @return 0 on success, -1 for an empty, malformed or too long list.
+ */
+int bench_parse_sizes(const char* list, BenchConfig* config) {
+    size_t count = 0;
+    const char* p = list;
+    while (*p) {
+        char* end;
+        double value = strtod(p, &end);
+        if (end == p || value < 3.0 || value > 4.0e9 || count == BENCH_MAX_SIZES) return -1;
+        config->sizes[count++] = (size_t)value;
+        if (*end == ',') {
+            end++;
+        } else if (*end != '\0') {
+            return -1;
+        }
+        p = end;
+    }
+    if (count == 0) return -1;
+    config->size_count = count;
+    return 0;
+}
+
+/**
+ * @brief Parses a comma-separated list of distribution names, or "all".
+ * @param list The list.
+ * @param mask Receives a bit mask of 1 << BenchDistribution.
+ * @return 0 on success, -1 for an unknown name.
+ */
+int bench_parse_distributions(const char* list, unsigned* mask) {
+    if (strcmp(list, "all") == 0) {
+        *mask = (1u << BENCH_DIST_COUNT) - 1;
+        return 0;
+    }
+    unsigned parsed = 0;
+    const char* p = list;
+    while (*p) {
+        const char* comma = strchr(p, ',');
+        size_t len = comma ? (size_t)(comma - p) : strlen(p);
+        int found = -1;
+        for (int d = 0; d < BENCH_DIST_COUNT; ++d) {
+            if (strlen(DIST_NAMES[d]) == len && strncmp(p, DIST_NAMES[d], len) == 0) found = d;
+        }
+        if (found < 0) return -1;
+        parsed |= 1u << found;
+        p += len + (comma ? 1 : 0);
+    }
+    if (parsed == 0) return -1;
+    *mask = parsed;
+    return 0;
+}
+
+/**
+ * @brief Name of a distribution, as accepted by --bench-dist.
+ * @param dist Distribution.
+ * @return Name, or "unknown".
+ */
+const char* bench_distribution_name(BenchDistribution dist) {
+    return ((unsigned)dist < BENCH_DIST_COUNT) ? DIST_NAMES[dist] : "unknown";
+}
+
+/**
+ * @brief Generates a synthetic point set.
+ *
+ * The same seed always gives the same points, so runs on different builds or machines
+ * time identical inputs.
+ * @param dist Distribution.
+ * @param count Number of points.
+ * @param is_3d 1 to draw z uniformly as well, 0 for z = 0.
+ * @param seed Random seed.
+ * @return New PointSet, or NULL on failure.
+ */
+PointSet* bench_generate_points(BenchDistribution dist, size_t count, int is_3d, unsigned long seed) {
+    PointSet* set = malloc(sizeof(PointSet));
+    if (!set) {
+        fprintf(stderr, "Memory allocation failed for points\n");
+        return NULL;
+    }
+    set->points = malloc((count > 0 ? count : 1) * sizeof(Point));
+    if (!set->points) {
+        free(set);
+        fprintf(stderr, "Memory allocation failed for points\n");
+        return NULL;
+    }
+    set->count = count;
+    set->is_3d = is_3d;
+
+    unsigned long long state = seed * 0x100000001B3ULL + (unsigned long long)dist;
+    double centres[BENCH_CLUSTERS][2];
+    for (int c = 0; c < BENCH_CLUSTERS; ++c) {
+        centres[c][0] = BENCH_SCALE * (0.1 + 0.8 * random_unit(&state));
+        centres[c][1] = BENCH_SCALE * (0.1 + 0.8 * random_unit(&state));
+    }
+    const double mid = BENCH_SCALE / 2.0;
+    for (size_t i = 0; i < count; ++i) {
+        double x, y, angle;
+        switch (dist) {
+            case BENCH_CIRCLE:
+                do {
+                    x = random_unit(&state) * 2.0 - 1.0;
+                    y = random_unit(&state) * 2.0 - 1.0;
+                } while (x * x + y * y >= 1.0);
+                x = mid + x * mid;
+                y = mid + y * mid;
+                break;
+            case BENCH_GAUSSIAN:
+                x = mid + random_normal(&state) * BENCH_SCALE / 10.0;
+                y = mid + random_normal(&state) * BENCH_SCALE / 10.0;
+                break;
+            case BENCH_CLUSTERED: {
+                const double* c = centres[next_random(&state) % BENCH_CLUSTERS];
+                x = c[0] + random_normal(&state) * BENCH_SCALE / 50.0;
+                y = c[1] + random_normal(&state) * BENCH_SCALE / 50.0;
+                break;
+            }
+            case BENCH_ON_HULL:
+                angle = 2.0 * BENCH_PI * random_unit(&state);
+                x = mid + mid * cos(angle);
+                y = mid + mid * sin(angle);
+                break;
+            default:
+                x = random_unit(&state) * BENCH_SCALE;
+                y = random_unit(&state) * BENCH_SCALE;
+                break;
+        }
+        set->points[i].x = (float)x;
+        set->points[i].y = (float)y;
+        set->points[i].z = is_3d ? (float)(random_unit(&state) * BENCH_SCALE) : 0.0f;
+    }
+    return set;
+}
+
+// Helper: qsort comparator for timings
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Computes min, median, nearest-rank p95 and mean of a set of timings.
+ * @param samples Timings (sorted in place).
+ * @param count Number of timings.
+ * @param summary Receives the statistics (all 0 for an empty set).
+ */
+void bench_summarize(double* samples, size_t count, BenchSummary* summary) {
+    memset(summary, 0, sizeof(*summary));
+    if (count == 0) return;
+    qsort(samples, count, sizeof(double), compare_double);
+    double sum = 0.0;
+    for (size_t i = 0; i < count; ++i) sum += samples[i];
+    summary->min = samples[0];
+    summary->median = count % 2 ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) / 2.0;
+    size_t rank = (size_t)ceil(0.95 * (double)count);
+    summary->p95 = samples[(rank > 0 ? rank : 1) - 1];
+    summary->mean = sum / (double)count;
+}
+
+// Helper: One load, cull, hull and metrics pass; fills one timing per column, returns the hull size
+static long run_case_once(const BenchConfig* config, const char* path, double* times) {
+    stats_reset();
+    double start = stats_now_ms();
+    PointSet* set = load_points_mmap(path, config->pool);
+    if (!set) return -1;
+    set->is_3d = config->is_3d;
+
+    const PointSet* input = set;
+    PointSet* survivors = NULL;
+    if (config->cull) {
+        survivors = cull_interior_points(set, NULL);
+        if (survivors) input = survivors;
+    }
+    PointSet* hull;
+    if (config->grid > 0.0) {
+        hull = compute_convex_hull_grid(input, config->grid, NULL);
+    } else if (strcmp(config->algo, "monotone") == 0) {
+        hull = compute_convex_hull_monotone(input, config->pool, NULL);
+    } else if (strcmp(config->algo, "parallel") == 0) {
+        hull = compute_convex_hull_parallel(input, config->pool, NULL);
+    } else if (strcmp(config->algo, "chan") == 0) {
+        hull = compute_convex_hull_chan(input, config->pool, NULL);
+    } else {
+        hull = compute_convex_hull(input, config->pool, NULL);
+    }
+    long hull_count = -1;
+    if (hull) {
+        volatile double sink;  // Keeps the metrics from being optimized away
+        double phase_start = stats_phase_begin();
+        sink = compute_area_accum(hull, config->accum) + compute_path_length_accum(hull, config->accum);
+        (void)sink;
+        stats_phase_end(STATS_PHASE_METRICS, phase_start);
+        hull_count = (long)hull->count;
+    }
+    times[BENCH_PHASES] = stats_now_ms() - start;
+    for (int p = 0; p < BENCH_PHASES; ++p) times[p] = stats_phase_ms((StatsPhase)p);
+
+    free_points(hull);
+    free_points(survivors);
+    free_points(set);
+    return hull_count;
+}
+
+// Helper: Writes the points to a new temporary CSV; returns 0 and fills path, or -1
+static int write_temp_csv(const PointSet* set, char* path, size_t path_size) {
+    const char* dir = getenv("TMPDIR");
+    snprintf(path, path_size, "%s/infrageocalc_bench_XXXXXX", dir && *dir ? dir : "/tmp");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        fprintf(stderr, "Cannot create a temporary file for the benchmark\n");
+        return -1;
+    }
+    close(fd);
+    if (save_points(set, path, BENCH_PRECISION) != 0) {
+        unlink(path);
+        return -1;
+    }
+    return 0;
+}
+
+// Helper: Column name for reports ("total" after the phases)
+static const char* column_name(int column) {
+    return column < BENCH_PHASES ? stats_phase_name((StatsPhase)column) : "total";
+}
+
+// Helper: Writes one case in the configured format
+static void report_case(const BenchConfig* config, FILE* out, BenchDistribution dist, size_t n, long hull_count,
+                        const BenchSummary* summaries, int first) {
+    const char* name = bench_distribution_name(dist);
+    if (config->format == BENCH_JSON) {
+        fprintf(out, "%s    {\"distribution\": \"%s\", \"points\": %zu, \"hull\": %ld, \"phases\": {",
+                first ? "" : ",\n", name, n, hull_count);
+        for (int c = 0; c < BENCH_COLUMNS; ++c) {
+            const BenchSummary* s = &summaries[c];
+            fprintf(out, "%s\"%s\": {\"min_ms\": %.6f, \"median_ms\": %.6f, \"p95_ms\": %.6f, \"mean_ms\": %.6f}",
+                    c ? ", " : "", column_name(c), s->min, s->median, s->p95, s->mean);
+        }
+        fprintf(out, "}}");
+    } else if (config->format == BENCH_CSV) {
+        for (int c = 0; c < BENCH_COLUMNS; ++c) {
+            const BenchSummary* s = &summaries[c];
+            fprintf(out, "%s,%zu,%ld,%s,%.6f,%.6f,%.6f,%.6f\n", name, n, hull_count, column_name(c),
+                    s->min, s->median, s->p95, s->mean);
+        }
+    } else {
+        fprintf(out, "%-9s n=%-8zu h=%-7ld", name, n, hull_count);
+        for (int p = 0; p < BENCH_PHASES; ++p) {
+            fprintf(out, " %s %.2f", column_name(p), summaries[p].median);
+        }
+        const BenchSummary* total = &summaries[BENCH_PHASES];
+        fprintf(out, " | total %.2f / %.2f / %.2f\n", total->min, total->median, total->p95);
+    }
+}
+
+/**
+ * @brief Runs the hull pipeline benchmark and writes the report.
+ *
+ * For every selected distribution and size, the points are generated, written to a temporary
+ * CSV, and then loaded, culled (optional), hulled and measured warmup + reps times. Every
+ * timing uses the monotonic wall clock. Load, cull, sort and scan are timed inside the library
+ * routines through the stats phase timers, which are enabled for the duration of the run. The report
+ * gives min, median and p95 per phase and for the whole pass.
+ * @param config Benchmark settings.
+ * @param out Report destination.
+ * @return 0 on success, -1 if any case failed (the remaining cases still run).
+ */
+int bench_run(const BenchConfig* config, FILE* out) {
+    int reps = config->reps > 0 ? config->reps : 1;
+    double* samples = malloc((size_t)reps * BENCH_COLUMNS * sizeof(double));
+    if (!samples) {
+        fprintf(stderr, "Memory allocation failed for benchmark\n");
+        return -1;
+    }
+    int was_enabled = stats_enabled();
+    stats_enable(1);
+
+    if (config->format == BENCH_JSON) {
+        fprintf(out, "{\n  \"config\": {\"algo\": \"%s\", \"grid\": %g, \"threads\": %zu, \"cull\": %s, \"dim\": %d, "
+                "\"simd\": \"%s\", \"reps\": %d, \"warmup\": %d},\n  \"results\": [\n",
+                config->algo, config->grid, thread_pool_size(config->pool), config->cull ? "true" : "false",
+                config->is_3d ? 3 : 2, simd_level_name(simd_get_level()), reps, config->warmup);
+    } else if (config->format == BENCH_CSV) {
+        fprintf(out, "distribution,points,hull,phase,min_ms,median_ms,p95_ms,mean_ms\n");
+    } else {
+        fprintf(out, "Hull pipeline (Algo: %s, Threads: %zu, Cull: %s, Dim: %s", config->algo,
+                thread_pool_size(config->pool), config->cull ? "on" : "off", config->is_3d ? "3D" : "2D");
+        if (config->grid > 0.0) fprintf(out, ", Grid: %g", config->grid);
+        fprintf(out, "): %d reps after %d warmup\n", reps, config->warmup);
+        fprintf(out, "Median ms per phase | total min / median / p95 ms\n");
+    }
+
+    int status = 0;
+    int first = 1;
+    for (int d = 0; d < BENCH_DIST_COUNT; ++d) {
+        if (!(config->distributions & (1u << d))) continue;
+        for (size_t s = 0; s < config->size_count; ++s) {
+            size_t n = config->sizes[s];
+            PointSet* set = bench_generate_points((BenchDistribution)d, n, config->is_3d, (unsigned long)n);
+            char path[4096];
+            int written = set ? write_temp_csv(set, path, sizeof(path)) : -1;
+            free_points(set);
+            if (written != 0) {
+                status = -1;
+                continue;
+            }
+
+            long hull_count = 0;
+            double times[BENCH_COLUMNS];
+            for (int r = 0; r < config->warmup + reps && hull_count >= 0; ++r) {
+                hull_count = run_case_once(config, path, times);
+                if (r >= config->warmup) {
+                    for (int c = 0; c < BENCH_COLUMNS; ++c) samples[c * reps + (r - config->warmup)] = times[c];
+                }
+            }
+            unlink(path);
+            if (hull_count < 0) {
+                fprintf(stderr, "Benchmark case %s n=%zu failed\n", bench_distribution_name((BenchDistribution)d), n);
+                status = -1;
+                continue;
+            }
+
+            BenchSummary summaries[BENCH_COLUMNS];
+            for (int c = 0; c < BENCH_COLUMNS; ++c) bench_summarize(samples + c * reps, (size_t)reps, &summaries[c]);
+            report_case(config, out, (BenchDistribution)d, n, hull_count, summaries, first);
+            first = 0;
+            fflush(out);
+        }
+    }
+    if (config->format == BENCH_JSON) fprintf(out, "\n  ]\n}\n");
+
+    stats_enable(was_enabled);
+    free(samples);
+    return status;
+}
+
+// Helper: Median wall time of reps runs, from per-run samples
+static double median_ms(double* samples, int reps) {
+    BenchSummary summary;
+    bench_summarize(samples, (size_t)reps, &summary);
+    return summary.median;
+}
+
+// Times each accumulation mode on a dense circle at UTM-sized coordinates and reports its error
+// against a long double reference (exact products, compensated sum)
+static void benchmark_accum(size_t count, int reps, double* samples, FILE* out) {
+    PointSet set = {malloc(count * sizeof(Point)), count, 0};
+    if (!set.points) return;
+    for (size_t i = 0; i < count; ++i) {
+        double angle = 2.0 * BENCH_PI * (double)i / count;
+        set.points[i].x = (float)(500000.0 + 1000.0 * cos(angle));
+        set.points[i].y = (float)(5000000.0 + 1000.0 * sin(angle));
+        set.points[i].z = 0.0f;
+    }
+    long double ref_area = 0.0L, area_comp = 0.0L, ref_length = 0.0L, length_comp = 0.0L;
+    for (size_t i = 0; i < count; ++i) {
+        const Point* a = &set.points[i];
+        const Point* b = &set.points[(i + 1) % count];
+        long double terms[2] = {(long double)a->x * b->y - (long double)b->x * a->y,
+                                sqrtl(((long double)a->x - b->x) * ((long double)a->x - b->x) +
+                                      ((long double)a->y - b->y) * ((long double)a->y - b->y))};
+        long double* sums[2] = {&ref_area, &ref_length};
+        long double* comps[2] = {&area_comp, &length_comp};
+        for (int k = 0; k < 2; ++k) {
+            long double y = terms[k] - *comps[k];
+            long double t = *sums[k] + y;
+            *comps[k] = (t - *sums[k]) - y;
+            *sums[k] = t;
+        }
+    }
+    ref_area = fabsl(ref_area) / 2.0L;
+
+    const char* names[] = {"float", "double", "kahan", "pairwise"};
+    volatile double sink = 0.0;
+    for (int m = ACCUM_FLOAT; m <= ACCUM_PAIRWISE; ++m) {
+        double area = 0.0, length = 0.0;
+        for (int r = 0; r < reps; ++r) {
+            double start = stats_now_ms();
+            area = compute_area_accum(&set, (AccumMode)m);
+            length = compute_path_length_accum(&set, (AccumMode)m);
+            samples[r] = stats_now_ms() - start;
+            sink += area + length;
+        }
+        fprintf(out, "Accum %-8s on %zu UTM points: %.2f ms, area rel. error %.1e, perimeter rel. error %.1e\n",
+                names[m], count, median_ms(samples, reps), (double)(fabsl(area - ref_area) / ref_area),
+                (double)(fabsl(length - ref_length) / ref_length));
+    }
+    free(set.points);
+}
+
+// Times the scan kernels on the same points in AoS and SoA layout (whole set treated as a polygon)
+static void benchmark_layouts(const PointSet* set, int reps, double* samples, FILE* out) {
+    PointSetSoA* soa = points_to_soa(set);
+    if (!soa) return;
+    volatile float sink = 0.0f;  // Keeps the kernels from being optimized away
+    volatile size_t index_sink = 0;
+    double aos_ms[3], soa_ms[3];
+
+    for (int r = 0; r < reps; ++r) {
+        double start = stats_now_ms();
+        sink += compute_area(set);
+        sink += compute_path_length(set);
+        samples[r] = stats_now_ms() - start;
+    }
+    aos_ms[0] = median_ms(samples, reps);
+    for (int r = 0; r < reps; ++r) {
+        double start = stats_now_ms();
+        sink += compute_area_soa(soa);
+        sink += compute_path_length_soa(soa);
+        samples[r] = stats_now_ms() - start;
+    }
+    soa_ms[0] = median_ms(samples, reps);
+
+    for (int r = 0; r < reps; ++r) {
+        double start = stats_now_ms();
+        size_t min_idx = 0;  // Same scan as the Graham pivot search
+        for (size_t i = 1; i < set->count; ++i) {
+            if (set->points[i].y < set->points[min_idx].y ||
+                (set->points[i].y == set->points[min_idx].y && set->points[i].x < set->points[min_idx].x)) {
+                min_idx = i;
+            }
+        }
+        index_sink += min_idx;
+        samples[r] = stats_now_ms() - start;
+    }
+    aos_ms[1] = median_ms(samples, reps);
+    for (int r = 0; r < reps; ++r) {
+        double start = stats_now_ms();
+        index_sink += find_pivot_soa(soa);
+        samples[r] = stats_now_ms() - start;
+    }
+    soa_ms[1] = median_ms(samples, reps);
+
+    for (int r = 0; r < reps; ++r) {
+        double start = stats_now_ms();
+        PointSet* kept = cull_interior_points(set, NULL);
+        index_sink += kept ? kept->count : 0;
+        samples[r] = stats_now_ms() - start;
+        free_points(kept);
+    }
+    aos_ms[2] = median_ms(samples, reps);
+    for (int r = 0; r < reps; ++r) {
+        double start = stats_now_ms();
+        PointSetSoA* kept = cull_interior_points_soa(soa);
+        index_sink += kept ? kept->count : 0;
+        samples[r] = stats_now_ms() - start;
+        free_points_soa(kept);
+    }
+    soa_ms[2] = median_ms(samples, reps);
+
+    const char* names[] = {"area+length", "pivot", "cull"};
+    for (int k = 0; k < 3; ++k) {
+        fprintf(out, "Layout %zu points, %-11s: AoS %.2f ms, SoA %.2f ms (%.2fx)\n", set->count, names[k],
+                aos_ms[k], soa_ms[k], soa_ms[k] > 0 ? aos_ms[k] / soa_ms[k] : 0.0);
+    }
+    free_points_soa(soa);
+}
+
+// Times area+length at each SIMD level the CPU supports, in both layouts
+static void benchmark_simd(const PointSet* set, int reps, double* samples, FILE* out) {
+    PointSetSoA* soa = points_to_soa(set);
+    if (!soa) return;
+    volatile float sink = 0.0f;
+    SimdLevel best = simd_detect_level();
+    double scalar_ms = 0.0;
+    for (int level = SIMD_SCALAR; level <= (int)best; ++level) {
+        simd_set_level((SimdLevel)level);
+        for (int r = 0; r < reps; ++r) {
+            double start = stats_now_ms();
+            sink += compute_area(set);
+            sink += compute_path_length(set);
+            samples[r] = stats_now_ms() - start;
+        }
+        double aos_ms = median_ms(samples, reps);
+        for (int r = 0; r < reps; ++r) {
+            double start = stats_now_ms();
+            sink += compute_area_soa(soa);
+            sink += compute_path_length_soa(soa);
+            samples[r] = stats_now_ms() - start;
+        }
+        double soa_ms = median_ms(samples, reps);
+        if (level == SIMD_SCALAR) scalar_ms = aos_ms;
+        fprintf(out, "SIMD %-6s area+length on %zu points: AoS %.2f ms, SoA %.2f ms (%.2fx vs scalar AoS)\n",
+                simd_level_name((SimdLevel)level), set->count, aos_ms, soa_ms, soa_ms > 0 ? scalar_ms / soa_ms : 0.0);
+    }
+    simd_set_level(best);
+    free_points_soa(soa);
+}
+
+/**
+ * @brief Runs the kernel micro-benchmarks: AoS vs SoA layout, SIMD levels and accumulation modes.
+ * @param count Points for the layout and SIMD kernels (the accumulation circle uses count / 4).
+ * @param is_3d 1 to include z.
+ * @param reps Timed repetitions per kernel (the median is reported).
+ * @param out Report destination.
+ */
+void bench_kernels(size_t count, int is_3d, int reps, FILE* out) {
+    if (reps < 1) reps = 1;
+    double* samples = malloc((size_t)reps * sizeof(double));
+    PointSet* set = bench_generate_points(BENCH_UNIFORM, count, is_3d, 1);
+    if (samples && set) {
+        benchmark_layouts(set, reps, samples, out);
+        benchmark_simd(set, reps, samples, out);
+        benchmark_accum(count / 4, reps, samples, out);
+    }
+    free_points(set);
+    free(samples);
+}
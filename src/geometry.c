@@ -1,195 +1,1563 @@
-#include "geometry.h"
-#include <stdlib.h>  // For qsort, malloc
-#include <math.h>    // For sqrt, fabs, atan2
-#include <float.h>   // For FLT_MAX
-#include <stdio.h>   // For fprintf, stderr
-#include <string.h>  // For memcpy
-#include <pthread.h> // For multithreading
-
-#define EPSILON 1e-6  // Small value for floating-point comparisons
-
-// Forward declarations for helpers
-static int compare_polar(const void* a, const void* b);
-static float cross_product(const Point* o, const Point* a, const Point* b);
-static Point* pivot = NULL;  // Global for qsort comparator (set in compute_convex_hull)
-
-// Thread arg struct for parallel sorting
-typedef struct {
-    Point* points;
-    size_t start;
-    size_t end;
-} SortArg;
-
-// Thread function for sorting a chunk
-static void* sort_chunk(void* arg) {
-    SortArg* s = (SortArg*)arg;
-    qsort(s->points + s->start, s->end - s->start, sizeof(Point), compare_polar);
-    return NULL;
-}
-
-/**
- * @brief Computes the Euclidean distance between two points (2D or 3D).
- * @param a First point.
- * @param b Second point.
- * @return Distance (float).
- */
-float compute_distance(const Point* a, const Point* b) {
-    float dx = a->x - b->x;
-    float dy = a->y - b->y;
-    float dz = a->z - b->z;
-    return sqrtf(dx*dx + dy*dy + dz*dz);  // dz=0 in 2D
-}
-
-/**
- * @brief Checks if three points are collinear.
- * @param a, b, c Points to check.
- * @return 1 if collinear, 0 otherwise.
- */
-int is_collinear(const Point* a, const Point* b, const Point* c) {
-    float cross = cross_product(a, b, c);
-    return fabsf(cross) < EPSILON;
-}
-
-// Helper: Cross product for orientation (2D: ignores z)
-static float cross_product(const Point* o, const Point* a, const Point* b) {
-    return (a->x - o->x) * (b->y - o->y) - (a->y - o->y) * (b->x - o->x);
-}
-
-// Helper: Comparator for qsort by polar angle from pivot (2D)
-static int compare_polar(const void* a, const void* b) {
-    const Point* pa = (const Point*)a;
-    const Point* pb = (const Point*)b;
-    float cross = cross_product(pivot, pa, pb);
-    if (fabsf(cross) < EPSILON) {
-        // Collinear: sort by distance
-        return (compute_distance(pivot, pa) < compute_distance(pivot, pb)) ? -1 : 1;
-    }
-    return (cross > 0) ? -1 : 1;  // Counterclockwise
-}
-
-/**
- * @brief Computes the convex hull of a point set using Graham's Scan (2D projection), with multithreading.
- * @param set Input PointSet.
- * @param num_threads Number of threads for parallel sorting.
- * @return New PointSet with hull points, or NULL on failure.
- */
-PointSet* compute_convex_hull(const PointSet* set, int num_threads) {
-    if (!set || set->count < 3) {
-        fprintf(stderr, "Convex hull requires at least 3 points\n");
-        return NULL;
-    }
-    if (num_threads < 1) num_threads = 1;  // Clamp
-
-    // Create a copy to sort
-    Point* points = malloc(set->count * sizeof(Point));
-    if (!points) {
-        fprintf(stderr, "Memory allocation failed for hull\n");
-        return NULL;
-    }
-    memcpy(points, set->points, set->count * sizeof(Point));
-
-    // Find pivot
-    size_t min_idx = 0;
-    for (size_t i = 1; i < set->count; ++i) {
-        if (points[i].y < points[min_idx].y || 
-            (points[i].y == points[min_idx].y && points[i].x < points[min_idx].x)) {
-            min_idx = i;
-        }
-    }
-    Point temp = points[0];
-    points[0] = points[min_idx];
-    points[min_idx] = temp;
-    pivot = &points[0];
-
-    // Parallel sort remaining points
-    size_t remaining = set->count - 1;
-    pthread_t threads[num_threads];
-    SortArg args[num_threads];
-    size_t chunk_size = remaining / num_threads;
-    size_t offset = 1;  // Start after pivot
-    for (int i = 0; i < num_threads; ++i) {
-        args[i].points = points;
-        args[i].start = offset;
-        args[i].end = offset + chunk_size + ((size_t)i < remaining % (size_t)num_threads ? 1 : 0);  // Fixed: cast i to size_t for comparison
-        if (args[i].start < args[i].end) {
-            pthread_create(&threads[i], NULL, sort_chunk, &args[i]);
-        }
-        offset = args[i].end;
-    }
-    for (int i = 0; i < num_threads; ++i) {
-        if (args[i].start < args[i].end) {
-            pthread_join(threads[i], NULL);
-        }
-    }
-    // Merge sorted chunks (simple but could use merge sort for better parallelism)
-    qsort(points + 1, remaining, sizeof(Point), compare_polar);  // Final merge sort
-
-    // Build hull (serial for simplicity)
-    PointSet* hull = malloc(sizeof(PointSet));
-    if (!hull) {
-        free(points);
-        return NULL;
-    }
-    hull->points = malloc(set->count * sizeof(Point));
-    if (!hull->points) {
-        free(hull);
-        free(points);
-        return NULL;
-    }
-    hull->count = 0;
-    hull->is_3d = set->is_3d;
-
-    hull->points[hull->count++] = points[0];
-    hull->points[hull->count++] = points[1];
-    if (set->count == 2) {
-        free(points);
-        return hull;
-    }
-    hull->points[hull->count++] = points[2];
-
-    for (size_t i = 3; i < set->count; ++i) {
-        while (hull->count >= 2 && cross_product(&hull->points[hull->count-2], 
-                                                 &hull->points[hull->count-1], 
-                                                 &points[i]) <= 0) {
-            hull->count--;
-        }
-        hull->points[hull->count++] = points[i];
-    }
-
-    hull->points = realloc(hull->points, hull->count * sizeof(Point));
-    free(points);
-    return hull;
-}
-
-/**
- * @brief Computes the area of a 2D polygon (convex hull) using shoelace formula.
- * @param hull The PointSet (assumed 2D polygon).
- * @return Area (float), or -1 on invalid input.
- */
-float compute_area(const PointSet* hull) {
-    if (!hull || hull->count < 3) return -1.0f;
-
-    float area = 0.0f;
-    for (size_t i = 0; i < hull->count; ++i) {
-        size_t j = (i + 1) % hull->count;
-        area += hull->points[i].x * hull->points[j].y;
-        area -= hull->points[j].x * hull->points[i].y;
-    }
-    return fabsf(area) / 2.0f;
-}
-
-/**
- * @brief Computes the total path length around the hull (perimeter).
- * @param hull The PointSet.
- * @return Total length (float), or -1 on invalid input.
- */
-float compute_path_length(const PointSet* hull) {
-    if (!hull || hull->count < 2) return -1.0f;
-
-    float length = 0.0f;
-    for (size_t i = 0; i < hull->count; ++i) {
-        size_t j = (i + 1) % hull->count;
-        length += compute_distance(&hull->points[i], &hull->points[j]);
-    }
-    return length;
-}
\ No newline at end of file
+#include "geometry.h"
+#include "simd.h"
+#include "predicates.h"
+#include "stats.h"
+#include "quantize.h"  // For radix_sort_words
+#include "cull.h"
+#include <stdlib.h>  // For qsort, malloc
+#include <math.h>    // For sqrt, fabs, atan2
+#include <float.h>   // For FLT_MAX
+#include <stdio.h>   // For fprintf, stderr
+#include <string.h>  // For memcpy
+#include <stdint.h>  // For uint64_t
+
+#define STREAM_HULL_RESERVE 1024  // Initial room for the running hull in streaming mode
+#define GRAHAM_ANGLE_SCALE 2147483648.0  // 2^31: pseudo-angle in [0, 2] to 32-bit fixed point
+#define INTO_INSERTION_MAX 64  // Up to this many points compute_convex_hull_into sorts by insertion
+#define CHAN_FIRST_GROUP 16  // Group size of Chan's first round; squared after every round that falls short
+#define SORT_BUFFER_ALIGN 16  // Alignment of each array carved out of a sort buffer
+
+// Forward declarations for helpers
+static int compare_polar(const void* a, const void* b);
+static int compare_lex(const void* a, const void* b);
+static int compare_polar_counted(const void* a, const void* b);
+static int compare_lex_counted(const void* a, const void* b);
+static int compare_index(const void* a, const void* b);
+static int compare_index_counted(const void* a, const void* b);
+static __thread const float* pivot = NULL;  // x, y of the Graham pivot (set in compute_convex_hull, copied to sort tasks)
+static __thread const Point* indexed = NULL;  // Points the sorted indices refer to (set in compute_convex_hull_indices)
+static __thread uint64_t comparisons = 0;  // Counted comparator calls on this thread, not yet flushed to stats
+
+// The hulls sort and scan copies of the input in the smallest layout that still carries what
+// the result needs: Point2 for 2D sets, Point for 3D sets (whose hull vertices keep their z).
+// x and y lead both layouts, so the comparators and the scan read them through a float pointer
+// and only the element size changes.
+
+// Thread arg struct for parallel sorting
+typedef struct {
+    unsigned char* points;
+    size_t size;  // Element size: sizeof(Point2) or sizeof(Point)
+    size_t start;
+    size_t end;
+    unsigned char* scratch;  // Same-sized buffer the chunk's merges ping-pong through
+    int (*cmp)(const void*, const void*);
+    const float* pivot;  // Submitting thread's pivot, for compare_polar on pool threads
+    const Point* indexed;  // Submitting thread's indexed points, for compare_index
+} SortArg;
+
+// Thread arg struct for merging a slice of two sorted runs into a destination buffer
+typedef struct {
+    const unsigned char* a;
+    size_t na;
+    const unsigned char* b;
+    size_t nb;
+    unsigned char* out;
+    size_t size;
+    int (*cmp)(const void*, const void*);
+    const float* pivot;
+    const Point* indexed;
+} MergeArg;
+
+// Helper: Copies one sort element: a point of either layout (fixed-size copies compile to plain
+// moves) or, for the index hull, a uint32 index
+static inline void copy_point(void* dst, const void* src, size_t size) {
+    if (size == sizeof(Point2)) {
+        memcpy(dst, src, sizeof(Point2));
+    } else if (size == sizeof(Point)) {
+        memcpy(dst, src, sizeof(Point));
+    } else {
+        memcpy(dst, src, size);
+    }
+}
+
+// Helper: Robust orientation of three points of either layout
+static inline double orient_xy(const void* a, const void* b, const void* c) {
+    const float* pa = (const float*)a;
+    const float* pb = (const float*)b;
+    const float* pc = (const float*)c;
+    return orient2d_xy(pa[0], pa[1], pb[0], pb[1], pc[0], pc[1]);
+}
+
+// Helper: Moves this thread's comparison count into STATS_COMPARISONS
+static void flush_comparisons(void) {
+    stats_add(STATS_COMPARISONS, comparisons);
+    comparisons = 0;
+}
+
+// Helper: Merges sorted runs a and b into out, taking from b only when strictly smaller (stable)
+static void merge_runs(const unsigned char* a, size_t na, const unsigned char* b, size_t nb,
+                       unsigned char* out, size_t size, int (*cmp)(const void*, const void*)) {
+    size_t i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        if (cmp(b + j * size, a + i * size) < 0) {
+            copy_point(out + k++ * size, b + j++ * size, size);
+        } else {
+            copy_point(out + k++ * size, a + i++ * size, size);
+        }
+    }
+    memcpy(out + k * size, a + i * size, (na - i) * size);
+    k += na - i;
+    if (nb > j) memcpy(out + k * size, b + j * size, (nb - j) * size);
+}
+
+// Helper: Stable merge sort of n elements through a same-sized scratch buffer. Unlike qsort,
+// which mallocs its own buffer for large inputs, it allocates nothing.
+static void merge_sort_run(unsigned char* points, unsigned char* scratch, size_t n, size_t size,
+                           int (*cmp)(const void*, const void*)) {
+    const size_t block = 16;
+    for (size_t lo = 0; lo < n; lo += block) {  // Insertion sort small blocks; scratch holds the key
+        size_t hi = lo + block < n ? lo + block : n;
+        for (size_t i = lo + 1; i < hi; ++i) {
+            size_t j = i;
+            while (j > lo && cmp(points + (j - 1) * size, points + i * size) > 0) --j;
+            if (j == i) continue;
+            memcpy(scratch, points + i * size, size);
+            memmove(points + (j + 1) * size, points + j * size, (i - j) * size);
+            memcpy(points + j * size, scratch, size);
+        }
+    }
+    unsigned char* src = points;
+    unsigned char* dst = scratch;
+    for (size_t width = block; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = lo + width < n ? lo + width : n;
+            size_t hi = lo + 2 * width < n ? lo + 2 * width : n;
+            merge_runs(src + lo * size, mid - lo, src + mid * size, hi - mid, dst + lo * size, size, cmp);
+        }
+        unsigned char* t = src;
+        src = dst;
+        dst = t;
+    }
+    if (src != points) memcpy(points, src, n * size);
+}
+
+// Task function for sorting a chunk (restores this thread's comparator state, which a helping
+// caller may still need)
+static void sort_chunk(void* arg) {
+    SortArg* s = (SortArg*)arg;
+    const float* saved_pivot = pivot;
+    const Point* saved_indexed = indexed;
+    pivot = s->pivot;
+    indexed = s->indexed;
+    merge_sort_run(s->points + s->start * s->size, s->scratch + s->start * s->size, s->end - s->start,
+                   s->size, s->cmp);
+    pivot = saved_pivot;
+    indexed = saved_indexed;
+    flush_comparisons();
+}
+
+// Task function for merging two sorted runs (takes from b only when strictly smaller)
+static void merge_chunk(void* arg) {
+    MergeArg* m = (MergeArg*)arg;
+    const float* saved_pivot = pivot;
+    const Point* saved_indexed = indexed;
+    pivot = m->pivot;
+    indexed = m->indexed;
+    merge_runs(m->a, m->na, m->b, m->nb, m->out, m->size, m->cmp);
+    pivot = saved_pivot;
+    indexed = saved_indexed;
+    flush_comparisons();
+}
+
+// Helper: Number of elements of sorted run b that order strictly before key
+static size_t lower_bound(const unsigned char* b, size_t nb, size_t size, const void* key,
+                          int (*cmp)(const void*, const void*)) {
+    size_t lo = 0, hi = nb;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (cmp(b + mid * size, key) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Helper: Number of threads parallel_sort splits n elements over (1: serial)
+static size_t sort_threads(ThreadPool* pool, size_t n) {
+    size_t threads_n = thread_pool_parallelism(pool, n);
+    return n < 2 * threads_n ? 1 : threads_n;
+}
+
+// Helper: Rounds bytes up to SORT_BUFFER_ALIGN
+static size_t sort_align(size_t bytes) {
+    return (bytes + SORT_BUFFER_ALIGN - 1) / SORT_BUFFER_ALIGN * SORT_BUFFER_ALIGN;
+}
+
+// Helper: Bytes of buffer sort_with_buffer needs for n elements of the given size: the merge
+// scratch, plus the run bounds and task args when the sort is split over the pool
+static size_t sort_buffer_bytes(ThreadPool* pool, size_t n, size_t size) {
+    size_t threads_n = sort_threads(pool, n);
+    if (threads_n == 1) return n * size;
+    return sort_align(n * size) + 2 * sort_align((threads_n + 1) * sizeof(size_t)) +
+           sort_align(threads_n * sizeof(SortArg)) + (threads_n + 1) * sizeof(MergeArg);
+}
+
+// Helper: Sorts n points of the given element size with per-thread chunk sorts followed by a
+// parallel tree merge. Each merge round splits every pair of runs into slices by binary search
+// so all threads stay busy down to the last round. All working memory is carved out of buffer,
+// which must be 16-byte aligned; a buffer smaller than sort_buffer_bytes falls back to qsort,
+// and a serial sort (no pool, or below the pool's inline threshold) is a merge sort in buffer.
+static void sort_with_buffer(void* base, size_t n, size_t size, int (*cmp)(const void*, const void*),
+                             ThreadPool* pool, void* buffer, size_t buffer_bytes) {
+    unsigned char* points = (unsigned char*)base;
+    size_t threads_n = sort_threads(pool, n);
+    if (!buffer || buffer_bytes < sort_buffer_bytes(pool, n, size)) {
+        qsort(points, n, size, cmp);
+        flush_comparisons();
+        return;
+    }
+    if (threads_n == 1) {
+        merge_sort_run(points, buffer, n, size, cmp);
+        flush_comparisons();
+        return;
+    }
+
+    unsigned char* scratch = buffer;
+    size_t* bounds = (size_t*)(scratch + sort_align(n * size));
+    size_t* next_bounds = (size_t*)((unsigned char*)bounds + sort_align((threads_n + 1) * sizeof(size_t)));
+    SortArg* sort_args = (SortArg*)((unsigned char*)next_bounds + sort_align((threads_n + 1) * sizeof(size_t)));
+    MergeArg* merge_args = (MergeArg*)((unsigned char*)sort_args + sort_align(threads_n * sizeof(SortArg)));
+
+    // Phase 1: sort one contiguous chunk per thread
+    size_t runs = threads_n;
+    for (size_t i = 0; i <= runs; ++i) {
+        bounds[i] = n * i / runs;
+    }
+    for (size_t i = 0; i < runs; ++i) {
+        sort_args[i].points = points;
+        sort_args[i].size = size;
+        sort_args[i].start = bounds[i];
+        sort_args[i].end = bounds[i + 1];
+        sort_args[i].scratch = scratch;
+        sort_args[i].cmp = cmp;
+        sort_args[i].pivot = pivot;
+        sort_args[i].indexed = indexed;
+    }
+    thread_pool_run(pool, sort_chunk, sort_args, sizeof(SortArg), runs);
+
+    // Phase 2: merge runs pairwise, ping-ponging between points and scratch
+    unsigned char* src = points;
+    unsigned char* dst = scratch;
+    while (runs > 1) {
+        size_t pairs = runs / 2;
+        size_t parts = threads_n / pairs;
+        if (parts < 1) parts = 1;
+        size_t tasks = 0;
+        for (size_t p = 0; p < pairs; ++p) {
+            size_t a0 = bounds[2 * p], a1 = bounds[2 * p + 1], b1 = bounds[2 * p + 2];
+            size_t na = a1 - a0, nb = b1 - a1;
+            size_t prev_i = 0, prev_j = 0;
+            for (size_t q = 1; q <= parts; ++q) {
+                size_t i = (q == parts) ? na : na * q / parts;
+                size_t j = (q == parts) ? nb : lower_bound(src + a1 * size, nb, size, src + (a0 + i) * size, cmp);
+                merge_args[tasks].a = src + (a0 + prev_i) * size;
+                merge_args[tasks].na = i - prev_i;
+                merge_args[tasks].b = src + (a1 + prev_j) * size;
+                merge_args[tasks].nb = j - prev_j;
+                merge_args[tasks].out = dst + (a0 + prev_i + prev_j) * size;
+                merge_args[tasks].size = size;
+                merge_args[tasks].cmp = cmp;
+                merge_args[tasks].pivot = pivot;
+                merge_args[tasks].indexed = indexed;
+                tasks++;
+                prev_i = i;
+                prev_j = j;
+            }
+            next_bounds[p] = a0;
+        }
+        if (runs % 2 == 1) {
+            // Odd run out: carried over unchanged
+            size_t a0 = bounds[runs - 1];
+            merge_args[tasks].a = src + a0 * size;
+            merge_args[tasks].na = bounds[runs] - a0;
+            merge_args[tasks].b = NULL;
+            merge_args[tasks].nb = 0;
+            merge_args[tasks].out = dst + a0 * size;
+            merge_args[tasks].size = size;
+            merge_args[tasks].cmp = cmp;
+            merge_args[tasks].pivot = pivot;
+            merge_args[tasks].indexed = indexed;
+            tasks++;
+            next_bounds[pairs] = a0;
+        }
+        thread_pool_run(pool, merge_chunk, merge_args, sizeof(MergeArg), tasks);
+
+        runs = (runs + 1) / 2;
+        next_bounds[runs] = n;
+        size_t* tmp_bounds = bounds;
+        bounds = next_bounds;
+        next_bounds = tmp_bounds;
+        unsigned char* tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    if (src != points) {
+        memcpy(points, src, n * size);
+    }
+    flush_comparisons();  // Split searches ran on this thread
+}
+
+// Helper: sort_with_buffer with its buffer from arena (NULL: heap). Serial sorts without an
+// arena stay plain qsort, so they allocate nothing that STATS_ALLOCATIONS would count.
+static void parallel_sort(void* base, size_t n, size_t size, int (*cmp)(const void*, const void*),
+                          ThreadPool* pool, Arena* arena) {
+    if (!arena && sort_threads(pool, n) == 1) {
+        qsort(base, n, size, cmp);
+        flush_comparisons();
+        return;
+    }
+    size_t bytes = sort_buffer_bytes(pool, n, size);
+    void* buffer = arena_alloc(arena, bytes);  // NULL on OOM: sort_with_buffer falls back to qsort
+    sort_with_buffer(base, n, size, cmp, pool, buffer, bytes);
+    arena_free(arena, buffer);
+}
+
+// Helper: Element size of the hull's working copies of set
+static size_t hull_point_size(const PointSet* set) {
+    return set->is_3d ? sizeof(Point) : sizeof(Point2);
+}
+
+// Helper: Copies set's points into dst in the layout of hull_point_size (drops z for 2D sets)
+static void pack_points(unsigned char* dst, const PointSet* set) {
+    if (set->is_3d) {
+        memcpy(dst, set->points, set->count * sizeof(Point));
+        return;
+    }
+    Point2* compact = (Point2*)dst;
+    for (size_t i = 0; i < set->count; ++i) {
+        compact[i].x = set->points[i].x;
+        compact[i].y = set->points[i].y;
+    }
+}
+
+// Helper: Turns a scan buffer (capacity bytes) holding count points of the given size into the
+// hull's Point array in place: a 3D buffer is shrunk, a compact one is grown and widened back to
+// front with z = 0, so no second buffer is needed. Returns NULL if growing fails (scan is then
+// still allocated).
+static Point* widen_hull(unsigned char* scan, size_t capacity, size_t count, size_t size, Arena* arena) {
+    if (count == 0) return (Point*)scan;
+    unsigned char* out = arena_resize(arena, scan, capacity, count * sizeof(Point));
+    if (size == sizeof(Point)) return (Point*)(out ? out : scan);  // A failed shrink is harmless
+    if (!out) return NULL;
+    for (size_t i = count; i-- > 0; ) {
+        // Byte copies: the two layouts overlap in the buffer
+        float xyz[3] = {0.0f, 0.0f, 0.0f};
+        memcpy(xyz, out + i * sizeof(Point2), sizeof(Point2));
+        memcpy(out + i * sizeof(Point), xyz, sizeof(Point));
+    }
+    return (Point*)out;
+}
+
+// Helper: Graham scan of n points sorted around points[0] into scan; returns the hull size.
+// Scanning from the second point also drops duplicates of the pivot and collinear starts.
+// Inlined per element size (see scan_graham) so the stride is a constant.
+static inline size_t graham_scan(const unsigned char* points, size_t n, unsigned char* scan, size_t size,
+                                 size_t* pops) {
+    size_t k = 0;
+    copy_point(scan, points, size);
+    k++;
+    for (size_t i = 1; i < n; ++i) {
+        const unsigned char* p = points + i * size;
+        while (k >= 2 && orient_xy(scan + (k-2) * size, scan + (k-1) * size, p) <= 0) {
+            k--;
+            (*pops)++;
+        }
+        copy_point(scan + k++ * size, p, size);
+    }
+    return k;
+}
+
+// Helper: graham_scan specialized for each layout
+static size_t scan_graham(const unsigned char* points, size_t n, unsigned char* scan, size_t size, size_t* pops) {
+    return size == sizeof(Point2) ? graham_scan(points, n, scan, sizeof(Point2), pops)
+                                  : graham_scan(points, n, scan, sizeof(Point), pops);
+}
+
+// Helper: Monotone chain over n points sorted by (x, y) into scan (room for n + 1); returns the
+// chain length, whose last point repeats the first. Inlined per element size (see scan_monotone).
+static inline size_t monotone_scan(const unsigned char* points, size_t n, unsigned char* scan, size_t size,
+                                   size_t* pops) {
+    // Lower chain, left to right
+    size_t k = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const unsigned char* p = points + i * size;
+        while (k >= 2 && orient_xy(scan + (k-2) * size, scan + (k-1) * size, p) <= 0) {
+            k--;
+            (*pops)++;
+        }
+        copy_point(scan + k++ * size, p, size);
+    }
+    // Upper chain, right to left
+    size_t lower_size = k + 1;
+    for (size_t i = n - 1; i-- > 0; ) {
+        const unsigned char* p = points + i * size;
+        while (k >= lower_size && orient_xy(scan + (k-2) * size, scan + (k-1) * size, p) <= 0) {
+            k--;
+            (*pops)++;
+        }
+        copy_point(scan + k++ * size, p, size);
+    }
+    return k;
+}
+
+// Helper: monotone_scan specialized for each layout
+static size_t scan_monotone(const unsigned char* points, size_t n, unsigned char* scan, size_t size, size_t* pops) {
+    return size == sizeof(Point2) ? monotone_scan(points, n, scan, sizeof(Point2), pops)
+                                  : monotone_scan(points, n, scan, sizeof(Point), pops);
+}
+
+/**
+ * @brief Computes the Euclidean distance between two points (2D or 3D).
+ * @param a First point.
+ * @param b Second point.
+ * @return Distance (float).
+ */
+float compute_distance(const Point* a, const Point* b) {
+    float dx = a->x - b->x;
+    float dy = a->y - b->y;
+    float dz = a->z - b->z;
+    return sqrtf(dx*dx + dy*dy + dz*dz);  // dz=0 in 2D
+}
+
+/**
+ * @brief Checks if three points are collinear.
+ *
+ * Uses the robust orientation predicate, so the answer is exact for the float inputs: no
+ * tolerance is involved and nearly collinear points at large coordinates are not misreported.
+ * @param a, b, c Points to check.
+ * @return 1 if collinear, 0 otherwise.
+ */
+int is_collinear(const Point* a, const Point* b, const Point* c) {
+    return orient2d(a, b, c) == 0.0;
+}
+
+// Helper: Comparator for qsort by polar angle from pivot (2D, either layout)
+static int compare_polar(const void* a, const void* b) {
+    const float* pa = (const float*)a;  // x, y
+    const float* pb = (const float*)b;
+    double orient = orient2d_xy(pivot[0], pivot[1], pa[0], pa[1], pb[0], pb[1]);
+    if (orient == 0.0) {
+        // Collinear: the pivot is the lowest point, so both lie on one ray; nearer first.
+        // |dx| (or |dy| on a vertical ray) orders them exactly without computing distances.
+        double dxa = fabs((double)pa[0] - pivot[0]), dxb = fabs((double)pb[0] - pivot[0]);
+        if (dxa != dxb) return dxa < dxb ? -1 : 1;
+        double dya = fabs((double)pa[1] - pivot[1]), dyb = fabs((double)pb[1] - pivot[1]);
+        return (dya > dyb) - (dya < dyb);
+    }
+    return (orient > 0) ? -1 : 1;  // Counterclockwise
+}
+
+// Helper: Comparator for qsort by (x, y), either layout; reads no shared state, so it is safe to use concurrently
+static int compare_lex(const void* a, const void* b) {
+    const float* pa = (const float*)a;
+    const float* pb = (const float*)b;
+    if (pa[0] < pb[0]) return -1;
+    if (pa[0] > pb[0]) return 1;
+    if (pa[1] < pb[1]) return -1;
+    if (pa[1] > pb[1]) return 1;
+    return 0;
+}
+
+// Helper: Comparator for qsort of uint32 indices into indexed, by (x, y) and then by index, so
+// duplicates keep their input order whatever the sort
+static int compare_index(const void* a, const void* b) {
+    uint32_t ia = *(const uint32_t*)a, ib = *(const uint32_t*)b;
+    int order = compare_lex(&indexed[ia], &indexed[ib]);
+    if (order != 0) return order;
+    return (ia > ib) - (ia < ib);
+}
+
+// Helper: Comparators that also count calls; the hulls pick them only while stats are enabled
+static int compare_polar_counted(const void* a, const void* b) {
+    comparisons++;
+    return compare_polar(a, b);
+}
+
+static int compare_lex_counted(const void* a, const void* b) {
+    comparisons++;
+    return compare_lex(a, b);
+}
+
+static int compare_index_counted(const void* a, const void* b) {
+    comparisons++;
+    return compare_index(a, b);
+}
+
+// Task arg for the Graham sort keys and the gather over a range of points
+typedef struct {
+    const Point* points;  // Input points
+    uint64_t* keys;       // Per point: sort key, then the point's input index
+    unsigned char* out;   // Gather target in the hull layout
+    size_t size;          // Element size of out
+    float pivot_x;
+    float pivot_y;
+    size_t start;         // Points [start, end)
+    size_t end;
+} GrahamKeyArg;
+
+// Helper: Graham sort key of a point: a pseudo-angle from the pivot in the high 32 bits and the
+// float bits of the squared distance in the low 32 (non-negative floats order like their bits).
+// The pseudo-angle 1 - dx / (|dx| + dy) grows monotonically with the angle over [0, pi], which
+// is all of it since the pivot is the lowest point; it needs no atan2 or sqrt. Pivot duplicates
+// get key 0. Keys are rounded, so near ties can come out swapped (see settle_order).
+static inline uint64_t graham_key(float x, float y, float pivot_x, float pivot_y) {
+    double dx = (double)x - pivot_x, dy = (double)y - pivot_y;
+    double span = fabs(dx) + dy;
+    if (span == 0.0) return 0;
+    double angle = (1.0 - dx / span) * GRAHAM_ANGLE_SCALE;
+    uint64_t high = angle >= 4294967295.0 ? 0xffffffffu : (uint64_t)angle;
+    float dist = (float)(dx * dx + dy * dy);
+    uint32_t dist_bits;
+    memcpy(&dist_bits, &dist, sizeof(dist_bits));
+    return high << 32 | dist_bits;
+}
+
+// Task function: computes the sort keys of a range of points
+static void graham_keys(void* arg) {
+    GrahamKeyArg* g = (GrahamKeyArg*)arg;
+    for (size_t i = g->start; i < g->end; ++i) {
+        g->keys[2 * i] = graham_key(g->points[i].x, g->points[i].y, g->pivot_x, g->pivot_y);
+        g->keys[2 * i + 1] = i;
+    }
+}
+
+// Task function: copies a range of points, in key order, into the hull layout
+static void graham_gather(void* arg) {
+    GrahamKeyArg* g = (GrahamKeyArg*)arg;
+    for (size_t i = g->start; i < g->end; ++i) {
+        const Point* p = &g->points[g->keys[2 * i + 1]];
+        if (g->size == sizeof(Point2)) {
+            Point2 compact = {p->x, p->y};
+            memcpy(g->out + i * sizeof(Point2), &compact, sizeof(Point2));
+        } else {
+            memcpy(g->out + i * sizeof(Point), p, sizeof(Point));
+        }
+    }
+}
+
+// Helper: Insertion sort of nearly sorted points by the exact comparator. Returns 0 if the
+// order is still unsettled after max_moves element moves (points are then a permutation of
+// the input), so a badly ordered input cannot turn quadratic.
+static int settle_order(unsigned char* points, size_t n, size_t size, int (*cmp)(const void*, const void*),
+                        size_t max_moves) {
+    size_t moves = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (cmp(points + (i-1) * size, points + i * size) <= 0) continue;
+        Point key;
+        copy_point(&key, points + i * size, size);
+        size_t j = i;
+        while (j > 0 && cmp(points + (j-1) * size, &key) > 0) {
+            copy_point(points + j * size, points + (j-1) * size, size);
+            j--;
+            if (++moves > max_moves) {
+                copy_point(points + j * size, &key, size);
+                return 0;
+            }
+        }
+        copy_point(points + j * size, &key, size);
+    }
+    return 1;
+}
+
+/**
+ * @brief Computes the convex hull of a point set using Graham's Scan (2D projection), with multithreading.
+ *
+ * The sort computes one integer key per point (pseudo-angle, then squared distance), radix
+ * sorts the keys over the pool and gathers the points once; an insertion pass with the exact
+ * comparator then fixes the few near ties that rounding swapped. The pivot is kept per thread,
+ * so the function can be called concurrently from several threads on different PointSets. 2D
+ * sets are sorted and scanned as 8-byte Point2 copies; only the hull vertices are widened back
+ * to Point.
+ * @param set Input PointSet.
+ * @param pool Thread pool for the key, radix and gather passes (NULL runs them on the calling thread).
+ * @param arena Arena for the sort copy, scratch and result (NULL: heap, free with free_points).
+ * @return New PointSet with hull points, or NULL on failure.
+ */
+PointSet* compute_convex_hull(const PointSet* set, ThreadPool* pool, Arena* arena) {
+    if (!set || set->count < 3) {
+        fprintf(stderr, "Convex hull requires at least 3 points\n");
+        return NULL;
+    }
+
+    // Find pivot
+    double phase_start = stats_phase_begin();
+    size_t n = set->count;
+    size_t min_idx = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (set->points[i].y < set->points[min_idx].y ||
+            (set->points[i].y == set->points[min_idx].y && set->points[i].x < set->points[min_idx].x)) {
+            min_idx = i;
+        }
+    }
+
+    // Sort keys, then gather the points into a compact copy in key order
+    size_t size = hull_point_size(set);
+    size_t tasks = thread_pool_parallelism(pool, n);
+    unsigned char* points = arena_alloc(arena, n * size);
+    GrahamKeyArg* args = arena_alloc(arena, tasks * sizeof(GrahamKeyArg));
+    uint64_t* keys = arena_alloc(arena, 2 * n * sizeof(uint64_t));
+    uint64_t* scratch = arena_alloc(arena, 2 * n * sizeof(uint64_t));
+    if (!points || !args || !keys || !scratch) {
+        arena_free(arena, scratch);
+        arena_free(arena, keys);
+        arena_free(arena, args);
+        arena_free(arena, points);
+        fprintf(stderr, "Memory allocation failed for hull\n");
+        return NULL;
+    }
+    float pivot_xy[2] = {set->points[min_idx].x, set->points[min_idx].y};
+    for (size_t i = 0; i < tasks; ++i) {
+        args[i].points = set->points;
+        args[i].keys = keys;
+        args[i].out = points;
+        args[i].size = size;
+        args[i].pivot_x = pivot_xy[0];
+        args[i].pivot_y = pivot_xy[1];
+        args[i].start = n * i / tasks;
+        args[i].end = n * (i + 1) / tasks;
+    }
+    thread_pool_run(pool, graham_keys, args, sizeof(GrahamKeyArg), tasks);
+    radix_sort_words(keys, scratch, n, 2, 1, pool, arena);  // Stable: the first of the pivot's duplicates leads
+    thread_pool_run(pool, graham_gather, args, sizeof(GrahamKeyArg), tasks);
+    arena_free(arena, scratch);
+    arena_free(arena, keys);
+    arena_free(arena, args);
+
+    // Exact order: the pivot and its duplicates stay in front, as nothing orders before them
+    pivot = pivot_xy;
+    int (*cmp)(const void*, const void*) = stats_enabled() ? compare_polar_counted : compare_polar;
+    if (!settle_order(points, n, size, cmp, n)) {
+        parallel_sort(points, n, size, cmp, pool, arena);
+    }
+    flush_comparisons();
+    stats_phase_end(STATS_PHASE_SORT, phase_start);
+    phase_start = stats_phase_begin();
+
+    // Build hull (serial for simplicity)
+    PointSet* hull = arena_alloc(arena, sizeof(PointSet));
+    if (!hull) {
+        arena_free(arena, points);
+        return NULL;
+    }
+    unsigned char* scan = arena_alloc(arena, n * size);
+    if (!scan) {
+        arena_free(arena, hull);
+        arena_free(arena, points);
+        return NULL;
+    }
+    hull->is_3d = set->is_3d;
+
+    size_t pops = 0;
+    size_t k = scan_graham(points, n, scan, size, &pops);
+    stats_add(STATS_HULL_POPS, pops);
+
+    hull->count = k;
+    hull->points = widen_hull(scan, n * size, k, size, arena);
+    if (!hull->points) {
+        arena_free(arena, scan);
+        arena_free(arena, hull);
+        arena_free(arena, points);
+        fprintf(stderr, "Memory allocation failed for hull\n");
+        return NULL;
+    }
+    arena_free(arena, points);
+    stats_phase_end(STATS_PHASE_SCAN, phase_start);
+    return hull;
+}
+
+/**
+ * @brief Computes the convex hull using Andrew's monotone chain (2D projection), with multithreading.
+ *
+ * Sorts lexicographically by (x, y) instead of by polar angle, so there is no pivot and no
+ * distance computation in the comparator. The function keeps no global state and can be called
+ * concurrently from several threads on different PointSets. 2D sets are sorted and scanned as
+ * 8-byte Point2 copies; only the hull vertices are widened back to Point.
+ * @param set Input PointSet.
+ * @param pool Thread pool for parallel sorting (NULL sorts on the calling thread).
+ * @param arena Arena for the sort copy, scratch and result (NULL: heap, free with free_points).
+ * @return New PointSet with hull points in counterclockwise order, or NULL on failure.
+ */
+PointSet* compute_convex_hull_monotone(const PointSet* set, ThreadPool* pool, Arena* arena) {
+    if (!set || set->count < 3) {
+        fprintf(stderr, "Convex hull requires at least 3 points\n");
+        return NULL;
+    }
+
+    size_t n = set->count;
+    size_t size = hull_point_size(set);
+    double phase_start = stats_phase_begin();
+    unsigned char* points = arena_alloc(arena, n * size);
+    if (!points) {
+        fprintf(stderr, "Memory allocation failed for hull\n");
+        return NULL;
+    }
+    pack_points(points, set);
+    parallel_sort(points, n, size, stats_enabled() ? compare_lex_counted : compare_lex, pool, arena);
+    stats_phase_end(STATS_PHASE_SORT, phase_start);
+    phase_start = stats_phase_begin();
+
+    PointSet* hull = arena_alloc(arena, sizeof(PointSet));
+    if (!hull) {
+        arena_free(arena, points);
+        return NULL;
+    }
+    unsigned char* scan = arena_alloc(arena, (n + 1) * size);  // Chain closes on the first point
+    if (!scan) {
+        arena_free(arena, hull);
+        arena_free(arena, points);
+        return NULL;
+    }
+    hull->is_3d = set->is_3d;
+
+    size_t pops = 0;
+    size_t k = scan_monotone(points, n, scan, size, &pops);
+    hull->count = k - 1;  // Last point repeats the first
+    stats_add(STATS_HULL_POPS, pops);
+
+    hull->points = widen_hull(scan, (n + 1) * size, hull->count, size, arena);
+    if (!hull->points) {
+        arena_free(arena, scan);
+        arena_free(arena, hull);
+        arena_free(arena, points);
+        fprintf(stderr, "Memory allocation failed for hull\n");
+        return NULL;
+    }
+    arena_free(arena, points);
+    stats_phase_end(STATS_PHASE_SCAN, phase_start);
+    return hull;
+}
+
+// Helper: Monotone chain over indices sorted by their points' (x, y) into chain (room for n + 1);
+// returns the chain length, whose last index repeats the first
+static size_t index_chain(const Point* points, const uint32_t* order, size_t n, uint32_t* chain, size_t* pops) {
+    // Lower chain, left to right
+    size_t k = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t p = order[i];
+        while (k >= 2 && orient2d(&points[chain[k-2]], &points[chain[k-1]], &points[p]) <= 0) {
+            k--;
+            (*pops)++;
+        }
+        chain[k++] = p;
+    }
+    // Upper chain, right to left
+    size_t lower_size = k + 1;
+    for (size_t i = n - 1; i-- > 0; ) {
+        uint32_t p = order[i];
+        while (k >= lower_size && orient2d(&points[chain[k-2]], &points[chain[k-1]], &points[p]) <= 0) {
+            k--;
+            (*pops)++;
+        }
+        chain[k++] = p;
+    }
+    return k;
+}
+
+/**
+ * @brief Computes the convex hull as indices into set, using Andrew's monotone chain (2D projection).
+ *
+ * Sorts 4-byte point indices instead of point copies and reads coordinates through them, so
+ * the working memory is 4 bytes per point for the order, its merge scratch and the chain, and
+ * the result still names the input rows (to look up attributes or source lines of the hull
+ * vertices). Of several duplicate points, the lowest index is kept.
+ * @param set Input PointSet (at most UINT32_MAX points).
+ * @param pool Thread pool for parallel sorting (NULL sorts on the calling thread).
+ * @param arena Arena for the indices and result (NULL: heap, free with free_hull_indices).
+ * @return New HullIndices in counterclockwise order, or NULL on failure.
+ */
+HullIndices* compute_convex_hull_indices(const PointSet* set, ThreadPool* pool, Arena* arena) {
+    if (!set || set->count < 3) {
+        fprintf(stderr, "Convex hull requires at least 3 points\n");
+        return NULL;
+    }
+    if (set->count > UINT32_MAX) {
+        fprintf(stderr, "Index hull supports at most %u points\n", UINT32_MAX);
+        return NULL;
+    }
+
+    size_t n = set->count;
+    double phase_start = stats_phase_begin();
+    uint32_t* order = arena_alloc(arena, n * sizeof(uint32_t));
+    if (!order) {
+        fprintf(stderr, "Memory allocation failed for hull\n");
+        return NULL;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        order[i] = (uint32_t)i;
+    }
+    indexed = set->points;
+    parallel_sort(order, n, sizeof(uint32_t), stats_enabled() ? compare_index_counted : compare_index, pool, arena);
+    stats_phase_end(STATS_PHASE_SORT, phase_start);
+    phase_start = stats_phase_begin();
+
+    HullIndices* hull = arena_alloc(arena, sizeof(HullIndices));
+    uint32_t* chain = hull ? arena_alloc(arena, (n + 1) * sizeof(uint32_t)) : NULL;  // Chain closes on the first index
+    if (!chain) {
+        arena_free(arena, hull);
+        arena_free(arena, order);
+        fprintf(stderr, "Memory allocation failed for hull\n");
+        return NULL;
+    }
+    size_t pops = 0;
+    size_t k = index_chain(set->points, order, n, chain, &pops);
+    stats_add(STATS_HULL_POPS, pops);
+    hull->count = k - 1;  // Last index repeats the first
+    uint32_t* shrunk = arena_resize(arena, chain, (n + 1) * sizeof(uint32_t), hull->count * sizeof(uint32_t));
+    hull->indices = shrunk ? shrunk : chain;  // A failed shrink is harmless
+    arena_free(arena, order);
+    stats_phase_end(STATS_PHASE_SCAN, phase_start);
+    return hull;
+}
+
+/**
+ * @brief Frees a heap HullIndices (arena results are released with their arena).
+ * @param hull HullIndices to free (NULL is ignored).
+ */
+void free_hull_indices(HullIndices* hull) {
+    if (!hull) return;
+    free(hull->indices);
+    free(hull);
+}
+
+// Helper: Float bits mapped so that unsigned order matches float order (-0 folded into +0)
+static inline uint32_t ordered_bits(float f) {
+    f += 0.0f;
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return (u & 0x80000000u) ? ~u : u | 0x80000000u;
+}
+
+// Helper: Inverse of ordered_bits
+static inline float from_ordered_bits(uint32_t u) {
+    u = (u & 0x80000000u) ? u & 0x7fffffffu : ~u;
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+// Helper: Orientation of three points given as (x, y) keys, x in the high half
+static inline double orient_keys(uint64_t a, uint64_t b, uint64_t c) {
+    return orient2d_xy(from_ordered_bits((uint32_t)(a >> 32)), from_ordered_bits((uint32_t)a),
+                       from_ordered_bits((uint32_t)(b >> 32)), from_ordered_bits((uint32_t)b),
+                       from_ordered_bits((uint32_t)(c >> 32)), from_ordered_bits((uint32_t)c));
+}
+
+// Helper: Monotone chain over n key elements of stride words, sorted by their first word, into
+// chain (room for n + 1); returns the chain length, whose last element repeats the first.
+// Inlined per stride (see key_chain).
+static inline size_t monotone_keys(const uint64_t* elems, size_t n, uint64_t* chain, size_t stride,
+                                   size_t* pops) {
+    // Lower chain, left to right
+    size_t k = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const uint64_t* p = elems + i * stride;
+        while (k >= 2 && orient_keys(chain[(k-2) * stride], chain[(k-1) * stride], *p) <= 0) {
+            k--;
+            (*pops)++;
+        }
+        memcpy(chain + k++ * stride, p, stride * sizeof(uint64_t));
+    }
+    // Upper chain, right to left
+    size_t lower_size = k + 1;
+    for (size_t i = n - 1; i-- > 0; ) {
+        const uint64_t* p = elems + i * stride;
+        while (k >= lower_size && orient_keys(chain[(k-2) * stride], chain[(k-1) * stride], *p) <= 0) {
+            k--;
+            (*pops)++;
+        }
+        memcpy(chain + k++ * stride, p, stride * sizeof(uint64_t));
+    }
+    return k;
+}
+
+// Helper: monotone_keys specialized for 2D (key only) and 3D (key, then z bits)
+static size_t key_chain(const uint64_t* elems, size_t n, uint64_t* chain, size_t stride, size_t* pops) {
+    return stride == 1 ? monotone_keys(elems, n, chain, 1, pops) : monotone_keys(elems, n, chain, 2, pops);
+}
+
+// Helper: Insertion sort of key elements by their first word, for inputs too small to pay for
+// the radix histograms
+static void insertion_sort_keys(uint64_t* elems, size_t n, size_t stride) {
+    for (size_t i = 1; i < n; ++i) {
+        uint64_t key[2];
+        memcpy(key, elems + i * stride, stride * sizeof(uint64_t));
+        size_t j = i;
+        while (j > 0 && elems[(j-1) * stride] > key[0]) {
+            memcpy(elems + j * stride, elems + (j-1) * stride, stride * sizeof(uint64_t));
+            j--;
+        }
+        memcpy(elems + j * stride, key, stride * sizeof(uint64_t));
+    }
+}
+
+/**
+ * @brief Bytes of scratch compute_convex_hull_into needs for a point set.
+ * @param count Number of input points.
+ * @param is_3d Non-zero if the hull vertices keep their z.
+ * @return Scratch size in bytes.
+ */
+size_t convex_hull_scratch_bytes(size_t count, int is_3d) {
+    size_t stride = is_3d ? 2 : 1;
+    return (2 * count + 1) * stride * sizeof(uint64_t);
+}
+
+// Helper: Untimed sort step of compute_convex_hull_into: builds and sorts set's keys in scratch
+static void hull_into_sort(const PointSet* set, void* scratch) {
+    size_t n = set->count;
+    size_t stride = set->is_3d ? 2 : 1;
+    uint64_t* elems = (uint64_t*)scratch;
+    uint64_t* spare = elems + n * stride;  // Radix scratch, then the chain (n + 1 elements)
+    for (size_t i = 0; i < n; ++i) {
+        const Point* p = &set->points[i];
+        elems[i * stride] = (uint64_t)ordered_bits(p->x) << 32 | ordered_bits(p->y);
+        if (stride == 2) {
+            uint32_t z_bits;
+            memcpy(&z_bits, &p->z, sizeof(z_bits));
+            elems[i * stride + 1] = z_bits;
+        }
+    }
+    if (n <= INTO_INSERTION_MAX) {
+        insertion_sort_keys(elems, n, stride);
+    } else {
+        radix_sort_words(elems, spare, n, stride, 1, NULL, NULL);  // Serial: allocates nothing
+    }
+}
+
+// Helper: Untimed scan step of compute_convex_hull_into over the n keys hull_into_sort left in
+// scratch; writes up to capacity vertices (out may alias the input points, which are no longer
+// read) and returns the full hull size
+static size_t hull_into_scan(void* scratch, size_t n, int is_3d, Point* out, size_t capacity, size_t* pops) {
+    size_t stride = is_3d ? 2 : 1;
+    uint64_t* elems = (uint64_t*)scratch;
+    uint64_t* spare = elems + n * stride;
+    size_t count = key_chain(elems, n, spare, stride, pops) - 1;  // Last element repeats the first
+    for (size_t i = 0; i < count && i < capacity; ++i) {
+        const uint64_t* e = spare + i * stride;
+        out[i].x = from_ordered_bits((uint32_t)(e[0] >> 32));
+        out[i].y = from_ordered_bits((uint32_t)e[0]);
+        out[i].z = 0.0f;
+        if (stride == 2) {
+            uint32_t z_bits = (uint32_t)e[1];
+            memcpy(&out[i].z, &z_bits, sizeof(z_bits));
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Computes the convex hull into caller-owned buffers, with no heap allocation.
+ *
+ * Andrew's monotone chain (2D projection) over one 64-bit key per point: x and y bits mapped
+ * to unsigned order, so the key is the point and the sort needs no comparator. Keys are radix
+ * sorted (insertion sorted up to INTO_INSERTION_MAX points) in scratch, which then holds the
+ * chain. Keeps no state between or during calls, so any number of threads can run it at once
+ * with their own buffers. Like snprintf, the return value is the full hull size even when
+ * capacity is smaller: then only the first capacity vertices are written and the caller can
+ * retry with a buffer of the returned size.
+ * @param set Input PointSet.
+ * @param scratch 8-byte aligned buffer of at least convex_hull_scratch_bytes(set->count, set->is_3d) bytes.
+ * @param scratch_bytes Size of scratch.
+ * @param out Hull vertices in counterclockwise order (may be NULL if capacity is 0).
+ * @param capacity Number of Points out can hold.
+ * @return Number of hull vertices, or -1 on invalid input or too little scratch.
+ */
+long compute_convex_hull_into(const PointSet* set, void* scratch, size_t scratch_bytes, Point* out, size_t capacity) {
+    if (!set || set->count < 3) {
+        fprintf(stderr, "Convex hull requires at least 3 points\n");
+        return -1;
+    }
+    size_t n = set->count;
+    size_t required = convex_hull_scratch_bytes(n, set->is_3d);
+    if (!scratch || scratch_bytes < required || (uintptr_t)scratch % sizeof(uint64_t) != 0) {
+        fprintf(stderr, "Hull scratch must be 8-byte aligned and hold %zu bytes\n", required);
+        return -1;
+    }
+    if (!out && capacity > 0) {
+        fprintf(stderr, "Hull output buffer is NULL\n");
+        return -1;
+    }
+
+    double phase_start = stats_phase_begin();
+    hull_into_sort(set, scratch);
+    stats_phase_end(STATS_PHASE_SORT, phase_start);
+    phase_start = stats_phase_begin();
+
+    size_t pops = 0;
+    size_t count = hull_into_scan(scratch, n, set->is_3d, out, capacity, &pops);
+    stats_add(STATS_HULL_POPS, pops);
+    stats_phase_end(STATS_PHASE_SCAN, phase_start);
+    return (long)count;
+}
+
+// Task arg for one partition of the divide-and-conquer hull
+typedef struct {
+    PointSet chunk;       // Contiguous slice of the input
+    void* scratch;        // convex_hull_scratch_bytes for the slice, reserved by the caller
+    Point* hull;          // Room for chunk.count vertices
+    size_t hull_count;    // Vertices written
+    size_t pops;          // Chain pops, added to STATS_HULL_POPS by the caller
+} PartitionArg;
+
+// Task function: hull of one partition into its reserved buffers, serial and allocation-free.
+// Untimed: the caller times the whole fan-out once, since per-worker phases would add up.
+static void hull_partition(void* arg) {
+    PartitionArg* p = (PartitionArg*)arg;
+    hull_into_sort(&p->chunk, p->scratch);
+    p->pops = 0;
+    p->hull_count = hull_into_scan(p->scratch, p->chunk.count, p->chunk.is_3d, p->hull, p->chunk.count, &p->pops);
+}
+
+/**
+ * @brief Computes the convex hull as a hull of per-thread hulls.
+ *
+ * The input is split into one contiguous partition per pool thread, and each thread runs a
+ * complete serial monotone chain (sort and scan) on its partition. Every vertex of the full
+ * hull is a vertex of its partition's hull, so the final monotone chain only has to run over
+ * the union of the partial hulls, which is usually a few hundred points. Unlike the other
+ * hulls, the scan is parallel too and only that last small step is serial. The partitions and
+ * the merge run compute_convex_hull_into's sort and scan on buffers reserved up front, so with
+ * an arena the whole call stays in it. Stats time the partition fan-out as the sort phase and
+ * the merge hull as the scan phase.
+ * @param set Input PointSet.
+ * @param pool Thread pool (NULL, or an input below the pool's inline threshold, runs the plain monotone chain).
+ * @param arena Arena for the partition buffers and result (NULL: heap, free with free_points).
+ * @return New PointSet with hull points in counterclockwise order, or NULL on failure.
+ */
+PointSet* compute_convex_hull_parallel(const PointSet* set, ThreadPool* pool, Arena* arena) {
+    if (!set || set->count < 3) {
+        fprintf(stderr, "Convex hull requires at least 3 points\n");
+        return NULL;
+    }
+    size_t n = set->count;
+    size_t parts = thread_pool_parallelism(pool, n);
+    if (parts == 1 || n < 3 * parts) {
+        return compute_convex_hull_monotone(set, pool, arena);
+    }
+
+    // Partition hulls land in their own slice of merged; scratch is split the same way
+    double phase_start = stats_phase_begin();
+    size_t scratch_total = 0;
+    for (size_t i = 0; i < parts; ++i) {
+        scratch_total += convex_hull_scratch_bytes(n * (i + 1) / parts - n * i / parts, set->is_3d);
+    }
+    Point* merged = arena_alloc(arena, n * sizeof(Point));
+    PartitionArg* args = merged ? arena_alloc(arena, parts * sizeof(PartitionArg)) : NULL;
+    unsigned char* scratch = args ? arena_alloc(arena, scratch_total) : NULL;
+    if (!scratch) {
+        arena_free(arena, args);
+        arena_free(arena, merged);
+        fprintf(stderr, "Memory allocation failed for hull\n");
+        return NULL;
+    }
+    size_t offset = 0;
+    for (size_t i = 0; i < parts; ++i) {
+        size_t start = n * i / parts, end = n * (i + 1) / parts;  // At least 3 points each
+        args[i].chunk.points = set->points + start;
+        args[i].chunk.count = end - start;
+        args[i].chunk.is_3d = set->is_3d;
+        args[i].scratch = scratch + offset;
+        args[i].hull = merged + start;
+        offset += convex_hull_scratch_bytes(end - start, set->is_3d);
+    }
+    thread_pool_run(pool, hull_partition, args, sizeof(PartitionArg), parts);
+
+    // Pack the partial hulls to the front of merged, in partition order
+    size_t total = 0;
+    size_t pops = 0;
+    for (size_t i = 0; i < parts; ++i) {
+        memmove(merged + total, args[i].hull, args[i].hull_count * sizeof(Point));
+        total += args[i].hull_count;
+        pops += args[i].pops;
+    }
+    stats_phase_end(STATS_PHASE_SORT, phase_start);
+    phase_start = stats_phase_begin();
+
+    // Merge hull on the calling thread: scratch_total covers the candidates, and merged can
+    // take the vertices in place
+    PointSet candidates = {merged, total, set->is_3d};
+    hull_into_sort(&candidates, scratch);
+    size_t count = hull_into_scan(scratch, total, set->is_3d, merged, total, &pops);
+    stats_add(STATS_HULL_POPS, pops);
+    arena_free(arena, scratch);
+    arena_free(arena, args);
+    PointSet* hull = arena_alloc(arena, sizeof(PointSet));
+    Point* points = hull ? arena_alloc(arena, count * sizeof(Point)) : NULL;
+    if (!points) {
+        arena_free(arena, hull);
+        arena_free(arena, merged);
+        fprintf(stderr, "Memory allocation failed for hull\n");
+        return NULL;
+    }
+    memcpy(points, merged, count * sizeof(Point));
+    hull->points = points;
+    hull->count = count;
+    hull->is_3d = set->is_3d;
+    arena_free(arena, merged);
+    stats_phase_end(STATS_PHASE_SCAN, phase_start);
+    return hull;
+}
+
+// Task arg for a range of Chan's groups
+typedef struct {
+    unsigned char* points;  // Packed input, grouped in runs of group_size
+    unsigned char* hulls;   // Per group: room for group_size + 1 vertices
+    size_t* counts;         // Per group: number of hull vertices
+    size_t n;
+    size_t size;            // Element size: sizeof(Point2) or sizeof(Point)
+    size_t group_size;
+    size_t first;           // Groups [first, last)
+    size_t last;
+    ThreadPool* pool;       // For sorting groups larger than a thread's share (else NULL)
+    unsigned char* sort_buffer;  // This task's sort_buffer_bytes for one group, reserved by the caller
+    size_t sort_buffer_bytes;
+} ChanArg;
+
+// Task function: sorts each group of the range and builds its monotone chain hull
+static void chan_mini_hulls(void* arg) {
+    ChanArg* c = (ChanArg*)arg;
+    size_t size = c->size;
+    size_t pops = 0;
+    for (size_t g = c->first; g < c->last; ++g) {
+        size_t start = g * c->group_size;
+        size_t count = c->n - start < c->group_size ? c->n - start : c->group_size;
+        unsigned char* points = c->points + start * size;
+        unsigned char* hull = c->hulls + g * (c->group_size + 1) * size;
+        sort_with_buffer(points, count, size, stats_enabled() ? compare_lex_counted : compare_lex, c->pool,
+                         c->sort_buffer, c->sort_buffer_bytes);
+        if (count == 1) {
+            copy_point(hull, points, size);
+            c->counts[g] = 1;
+        } else {
+            c->counts[g] = scan_monotone(points, count, hull, size, &pops) - 1;  // Last point repeats the first
+        }
+    }
+    stats_add(STATS_HULL_POPS, pops);
+}
+
+// Helper: Non-zero if a and b have the same x and y
+static inline int same_xy(const void* a, const void* b) {
+    const float* pa = (const float*)a;
+    const float* pb = (const float*)b;
+    return pa[0] == pb[0] && pa[1] == pb[1];
+}
+
+// Helper: Non-zero if b beats a as the next counterclockwise hull vertex after p: b is clockwise
+// of p->a, or on the same ray and farther (|dx|, then |dy|, orders collinear points exactly)
+static inline int wraps_before(const void* p, const void* a, const void* b) {
+    double orient = orient_xy(p, a, b);
+    if (orient != 0.0) return orient < 0;
+    const float* pp = (const float*)p;
+    const float* pa = (const float*)a;
+    const float* pb = (const float*)b;
+    double dxa = fabs((double)pa[0] - pp[0]), dxb = fabs((double)pb[0] - pp[0]);
+    if (dxa != dxb) return dxb > dxa;
+    return fabs((double)pb[1] - pp[1]) > fabs((double)pa[1] - pp[1]);
+}
+
+// Helper: Jarvis march over the mini-hulls from start, writing at most max_steps vertices to
+// out. Each group keeps a pointer to its tangent point; tangents only move counterclockwise as
+// the march does, so all pointer moves in one march add up to O(n). Returns the hull size, or
+// 0 if the hull has more than max_steps vertices. All-identical input gives 2 vertices.
+static size_t chan_wrap(const unsigned char* hulls, const size_t* counts, size_t groups, size_t group_size,
+                        size_t size, size_t* tangents, const void* start, size_t max_steps, unsigned char* out) {
+    size_t room = group_size + 1;
+    for (size_t g = 0; g < groups; ++g) {
+        // First tangents by full scan
+        const unsigned char* hull = hulls + g * room * size;
+        size_t best = 0;
+        for (size_t j = 0; j < counts[g]; ++j) {
+            if (same_xy(hull + j * size, start)) continue;
+            if (same_xy(hull + best * size, start) || wraps_before(start, hull + best * size, hull + j * size)) best = j;
+        }
+        tangents[g] = best;
+    }
+
+    copy_point(out, start, size);
+    size_t h = 1;
+    for (;;) {
+        const unsigned char* p = out + (h - 1) * size;
+        const unsigned char* next = NULL;
+        for (size_t g = 0; g < groups; ++g) {
+            size_t k = counts[g];
+            const unsigned char* hull = hulls + g * room * size;
+            size_t i = tangents[g];
+            for (size_t moves = 0; moves < k; ++moves) {
+                const unsigned char* cur = hull + i * size;
+                const unsigned char* succ = hull + ((i + 1) % k) * size;
+                if (!same_xy(cur, p) && !wraps_before(p, cur, succ)) break;
+                i = (i + 1) % k;
+            }
+            tangents[g] = i;
+            const unsigned char* candidate = hull + i * size;
+            if (same_xy(candidate, p)) continue;
+            if (!next || wraps_before(p, next, candidate)) next = candidate;
+        }
+        if (!next || same_xy(next, start)) {
+            if (h == 1) {
+                // Every point coincides with start: end on the last group's last vertex, as the
+                // monotone chain ends on the last sorted point, so all hulls return 2 points
+                const unsigned char* last = hulls + (groups - 1) * room * size;
+                copy_point(out + h++ * size, last + (counts[groups - 1] - 1) * size, size);
+            }
+            return h;  // Closed
+        }
+        if (h == max_steps) return 0;
+        copy_point(out + h++ * size, next, size);
+    }
+}
+
+// Helper: Releases one round of Chan's buffers
+static void free_chan_round(Arena* arena, unsigned char* hulls, size_t* counts, size_t* tangents,
+                            ChanArg* args, unsigned char* scan) {
+    arena_free(arena, scan);
+    arena_free(arena, args);
+    arena_free(arena, tangents);
+    arena_free(arena, counts);
+    arena_free(arena, hulls);
+}
+
+/**
+ * @brief Computes the convex hull with Chan's output-sensitive algorithm, O(n log h).
+ *
+ * Each round splits the points into groups of m, builds every group's hull with a monotone
+ * chain (groups are spread over the pool), and gift-wraps the group hulls for at most m
+ * steps. A round that does not close the hull squares m and tries again, starting from
+ * m = CHAN_FIRST_GROUP, so the sorts stay at O(log h) per point for hulls of h vertices.
+ * Wins over the O(n log n) hulls when h is small, as for dense survey data.
+ * @param set Input PointSet.
+ * @param pool Thread pool for the group hulls (NULL runs them on the calling thread).
+ * @param arena Arena for the working copy, group hulls, sort buffers and result (NULL: heap, free with free_points).
+ * @return New PointSet with hull points in counterclockwise order from the lowest point, or NULL on failure.
+ */
+PointSet* compute_convex_hull_chan(const PointSet* set, ThreadPool* pool, Arena* arena) {
+    if (!set || set->count < 3) {
+        fprintf(stderr, "Convex hull requires at least 3 points\n");
+        return NULL;
+    }
+    size_t n = set->count;
+    size_t size = hull_point_size(set);
+
+    // Start at the lowest point (leftmost among ties), which is always a hull vertex
+    size_t min_idx = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (set->points[i].y < set->points[min_idx].y ||
+            (set->points[i].y == set->points[min_idx].y && set->points[i].x < set->points[min_idx].x)) {
+            min_idx = i;
+        }
+    }
+    Point start = set->points[min_idx];
+    Point2 start_xy = {start.x, start.y};
+    const void* start_point = set->is_3d ? (const void*)&start : (const void*)&start_xy;
+
+    unsigned char* points = arena_alloc(arena, n * size);
+    if (!points) {
+        fprintf(stderr, "Memory allocation failed for hull\n");
+        return NULL;
+    }
+    pack_points(points, set);
+
+    size_t m = CHAN_FIRST_GROUP < n ? CHAN_FIRST_GROUP : n;
+    for (;;) {
+        double phase_start = stats_phase_begin();
+        size_t groups = (n + m - 1) / m;
+        size_t tasks = thread_pool_parallelism(pool, n);
+        ThreadPool* group_pool = tasks > groups ? pool : NULL;  // Few big groups: split their sorts instead
+        if (tasks > groups) tasks = groups;
+        size_t max_steps = m < n ? m : n;
+        unsigned char* hulls = arena_alloc(arena, groups * (m + 1) * size);
+        size_t* counts = arena_alloc(arena, groups * sizeof(size_t));
+        size_t* tangents = arena_alloc(arena, groups * sizeof(size_t));
+        ChanArg* args = arena_alloc(arena, tasks * sizeof(ChanArg));
+        unsigned char* scan = arena_alloc(arena, (max_steps + 1) * size);
+        size_t sort_bytes = sort_align(sort_buffer_bytes(group_pool, m, size));  // The largest group's
+        unsigned char* sort_buffers = arena_alloc(arena, tasks * sort_bytes);
+        if (!hulls || !counts || !tangents || !args || !scan || !sort_buffers) {
+            arena_free(arena, sort_buffers);
+            free_chan_round(arena, hulls, counts, tangents, args, scan);
+            arena_free(arena, points);
+            fprintf(stderr, "Memory allocation failed for hull\n");
+            return NULL;
+        }
+        for (size_t i = 0; i < tasks; ++i) {
+            args[i].points = points;
+            args[i].hulls = hulls;
+            args[i].counts = counts;
+            args[i].n = n;
+            args[i].size = size;
+            args[i].group_size = m;
+            args[i].first = groups * i / tasks;
+            args[i].last = groups * (i + 1) / tasks;
+            args[i].pool = group_pool;
+            args[i].sort_buffer = sort_buffers + i * sort_bytes;
+            args[i].sort_buffer_bytes = sort_bytes;
+        }
+        thread_pool_run(pool, chan_mini_hulls, args, sizeof(ChanArg), tasks);
+        arena_free(arena, sort_buffers);
+        stats_phase_end(STATS_PHASE_SORT, phase_start);
+
+        phase_start = stats_phase_begin();
+        size_t h = chan_wrap(hulls, counts, groups, m, size, tangents, start_point, max_steps, scan);
+        if (h > 0) {
+            PointSet* hull = arena_alloc(arena, sizeof(PointSet));
+            Point* vertices = hull ? widen_hull(scan, (max_steps + 1) * size, h, size, arena) : NULL;
+            if (!vertices) {
+                arena_free(arena, hull);
+                free_chan_round(arena, hulls, counts, tangents, args, scan);
+                arena_free(arena, points);
+                fprintf(stderr, "Memory allocation failed for hull\n");
+                return NULL;
+            }
+            hull->points = vertices;
+            hull->count = h;
+            hull->is_3d = set->is_3d;
+            free_chan_round(arena, hulls, counts, tangents, args, NULL);
+            arena_free(arena, points);
+            stats_phase_end(STATS_PHASE_SCAN, phase_start);
+            return hull;
+        }
+        free_chan_round(arena, hulls, counts, tangents, args, scan);
+        stats_phase_end(STATS_PHASE_SCAN, phase_start);
+        m = m > n / m ? n : m * m;
+    }
+}
+
+/**
+ * @brief Computes the convex hull of a point stream in bounded memory.
+ *
+ * Reads block_size points at a time into a buffer that already holds the running hull,
+ * then replaces the running hull by the monotone chain hull of the buffer. Peak memory is
+ * proportional to block_size plus the hull size, independent of the input size. Each block's
+ * sort copy and partial hull come from one arena that is reset per block, so after the first
+ * block the loop makes no heap allocations.
+ * @param reader Open point reader.
+ * @param block_size Points read per block.
+ * @param pool Thread pool for sorting each block (may be NULL).
+ * @param total_points Receives the number of points read (may be NULL).
+ * @return New PointSet with hull points in counterclockwise order, or NULL on failure.
+ */
+PointSet* compute_convex_hull_stream(PointReader* reader, size_t block_size, ThreadPool* pool, size_t* total_points) {
+    if (total_points) *total_points = 0;
+    if (!reader || block_size == 0) return NULL;
+
+    size_t capacity = block_size + STREAM_HULL_RESERVE;
+    Point* buffer = malloc(capacity * sizeof(Point));
+    Arena* scratch = arena_create(3 * capacity * sizeof(Point));  // Sort copy, merge scratch, partial hull
+    if (!buffer || !scratch) {
+        free(buffer);
+        arena_destroy(scratch);
+        fprintf(stderr, "Memory allocation failed for streaming hull\n");
+        return NULL;
+    }
+
+    size_t hull_count = 0;  // Running hull kept at the front of buffer
+    size_t total = 0;
+    size_t n;
+    while ((n = point_reader_read(reader, buffer + hull_count, block_size)) > 0) {
+        total += n;
+        size_t merged = hull_count + n;
+        if (merged < 3) {
+            hull_count = merged;  // Too few points to hull yet: keep them all
+            continue;
+        }
+
+        PointSet block = {buffer, merged, point_reader_is_3d(reader)};
+        PointSet* partial = compute_convex_hull_monotone(&block, pool, scratch);
+        if (!partial) {
+            free(buffer);
+            arena_destroy(scratch);
+            return NULL;
+        }
+        if (partial->count + block_size > capacity) {
+            capacity = partial->count * 2 + block_size;
+            Point* grown = realloc(buffer, capacity * sizeof(Point));
+            if (!grown) {
+                free(buffer);
+                arena_destroy(scratch);
+                fprintf(stderr, "Memory allocation failed for streaming hull\n");
+                return NULL;
+            }
+            buffer = grown;
+        }
+        memcpy(buffer, partial->points, partial->count * sizeof(Point));
+        hull_count = partial->count;
+        arena_reset(scratch);
+    }
+    arena_destroy(scratch);
+    if (total_points) *total_points = total;
+
+    if (point_reader_failed(reader) || total < 3) {
+        if (total < 3) fprintf(stderr, "Convex hull requires at least 3 points\n");
+        else fprintf(stderr, "Error reading input stream\n");
+        free(buffer);
+        return NULL;
+    }
+
+    PointSet* hull = malloc(sizeof(PointSet));
+    if (!hull) {
+        free(buffer);
+        return NULL;
+    }
+    hull->points = realloc(buffer, hull_count * sizeof(Point));
+    if (!hull->points) hull->points = buffer;
+    hull->count = hull_count;
+    hull->is_3d = point_reader_is_3d(reader);
+    return hull;
+}
+
+/**
+ * @brief Finds the Akl-Toussaint octagon and its edges for the AoS and SoA culls.
+ *
+ * Corners are min y, max x-y, max x, max x+y, max y, min x-y, min x and min x+y, in
+ * counterclockwise order, with repeated corners dropped.
+ * @param x First x-coordinate.
+ * @param y First y-coordinate.
+ * @param stride Floats between consecutive points (3 for Point, 1 for SoA arrays).
+ * @param n Number of points (non-zero).
+ * @param octagon Receives the edges when there are at least 3 corners.
+ * @return Corner count; below 3 the octagon is degenerate and nothing is strictly inside.
+ */
+size_t find_cull_octagon(const float* x, const float* y, size_t stride, size_t n, CullOctagon* octagon) {
+    size_t ext[CULL_EDGES] = {0};
+    for (size_t i = 1, j = stride; i < n; ++i, j += stride) {
+        float xi = x[j], yi = y[j];
+        if (yi < y[ext[0]]) ext[0] = j;
+        if (xi - yi > x[ext[1]] - y[ext[1]]) ext[1] = j;
+        if (xi > x[ext[2]]) ext[2] = j;
+        if (xi + yi > x[ext[3]] + y[ext[3]]) ext[3] = j;
+        if (yi > y[ext[4]]) ext[4] = j;
+        if (xi - yi < x[ext[5]] - y[ext[5]]) ext[5] = j;
+        if (xi < x[ext[6]]) ext[6] = j;
+        if (xi + yi < x[ext[7]] + y[ext[7]]) ext[7] = j;
+    }
+
+    float cx[CULL_EDGES], cy[CULL_EDGES];
+    size_t count = 0;
+    for (size_t k = 0; k < CULL_EDGES; ++k) {
+        float px = x[ext[k]], py = y[ext[k]];
+        if (count > 0 && px == cx[count-1] && py == cy[count-1]) continue;
+        cx[count] = px;
+        cy[count] = py;
+        count++;
+    }
+    while (count > 1 && cx[count-1] == cx[0] && cy[count-1] == cy[0]) {
+        count--;
+    }
+    if (count < 3) return count;
+
+    // Edge origins and directions, padded to a fixed 8 by repeating edges (repeats are harmless)
+    for (size_t k = 0; k < CULL_EDGES; ++k) {
+        size_t a = k % count, b = (k + 1) % count;
+        octagon->ox[k] = cx[a];
+        octagon->oy[k] = cy[a];
+        octagon->dx[k] = cx[b] - cx[a];
+        octagon->dy[k] = cy[b] - cy[a];
+    }
+    return count;
+}
+
+/**
+ * @brief Removes points strictly inside the Akl-Toussaint octagon before hull construction.
+ *
+ * The octagon spans the extreme points in x, y, x+y and x-y, so everything strictly inside it
+ * is strictly inside the hull. The filter is a single branch-free pass over the input; each
+ * edge test only discards a point when the float orientation exceeds its rounding error
+ * bound, so hull vertices are never culled.
+ * @param set Input PointSet.
+ * @param arena Arena for the result (NULL: heap, free with free_points).
+ * @return New PointSet with the surviving points (same order), or NULL on failure.
+ */
+PointSet* cull_interior_points(const PointSet* set, Arena* arena) {
+    if (!set) return NULL;
+    double phase_start = stats_phase_begin();
+
+    PointSet* out = arena_alloc(arena, sizeof(PointSet));
+    if (!out) {
+        fprintf(stderr, "Memory allocation failed for culling\n");
+        return NULL;
+    }
+    out->points = arena_alloc(arena, set->count * sizeof(Point));
+    if (!out->points) {
+        arena_free(arena, out);
+        fprintf(stderr, "Memory allocation failed for culling\n");
+        return NULL;
+    }
+    out->is_3d = set->is_3d;
+
+    CullOctagon octagon;
+    size_t corner_count = set->count > 0
+        ? find_cull_octagon(&set->points[0].x, &set->points[0].y, sizeof(Point) / sizeof(float), set->count, &octagon)
+        : 0;
+    if (corner_count < 3) {
+        // Degenerate octagon: nothing is strictly inside
+        memcpy(out->points, set->points, set->count * sizeof(Point));
+        out->count = set->count;
+        stats_phase_end(STATS_PHASE_CULL, phase_start);
+        return out;
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < set->count; ++i) {
+        int inside = cull_octagon_inside(&octagon, set->points[i].x, set->points[i].y);
+        out->points[kept] = set->points[i];
+        kept += (size_t)!inside;
+    }
+    out->count = kept;
+
+    if (kept > 0 && kept < set->count) {
+        Point* shrunk = arena_resize(arena, out->points, set->count * sizeof(Point), kept * sizeof(Point));
+        if (shrunk) out->points = shrunk;
+    }
+    stats_add(STATS_POINTS_CULLED, set->count - kept);
+    stats_phase_end(STATS_PHASE_CULL, phase_start);
+    return out;
+}
+
+/**
+ * @brief Computes the area of a 2D polygon (convex hull) using shoelace formula.
+ *
+ * Runs the widest SIMD kernel the CPU supports (see simd.c), with the closing edge handled
+ * outside the vector loop.
+ * @param hull The PointSet (assumed 2D polygon).
+ * @return Area (float), or -1 on invalid input.
+ */
+float compute_area(const PointSet* hull) {
+    if (!hull || hull->count < 3) return -1.0f;
+    return fabsf(simd_shoelace_aos(hull->points, hull->count)) / 2.0f;
+}
+
+/**
+ * @brief Computes the total path length around the hull (perimeter).
+ * @param hull The PointSet.
+ * @return Total length (float), or -1 on invalid input.
+ */
+float compute_path_length(const PointSet* hull) {
+    if (!hull || hull->count < 2) return -1.0f;
+    return simd_path_length_aos(hull->points, hull->count);
+}
+
+/**
+ * @brief Computes the polygon area with a selectable accumulation mode.
+ *
+ * The double modes form each shoelace term from exact double products, which keeps full
+ * precision at large survey coordinates where float terms cancel catastrophically.
+ * @param hull The PointSet (assumed 2D polygon).
+ * @param mode Accumulation mode.
+ * @return Area, or -1 on invalid input.
+ */
+double compute_area_accum(const PointSet* hull, AccumMode mode) {
+    if (!hull || hull->count < 3) return -1.0;
+    return fabs(simd_shoelace_accum_aos(hull->points, hull->count, mode)) / 2.0;
+}
+
+/**
+ * @brief Computes the hull perimeter with a selectable accumulation mode.
+ * @param hull The PointSet.
+ * @param mode Accumulation mode.
+ * @return Total length, or -1 on invalid input.
+ */
+double compute_path_length_accum(const PointSet* hull, AccumMode mode) {
+    if (!hull || hull->count < 2) return -1.0;
+    return simd_path_length_accum_aos(hull->points, hull->count, mode);
+}
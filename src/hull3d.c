@@ -0,0 +1,544 @@
+#include "geometry.h"
+#include <stdlib.h>  // For malloc, qsort
+#include <math.h>    // For sqrt, fabs
+#include <float.h>   // For DBL_EPSILON
+#include <stdio.h>   // For fprintf, stderr
+#include <string.h>  // For memset
+
+#define NONE ((size_t)-1)           // Missing face / empty list marker
+#define HULL3D_EPS_FACTOR 64.0      // Plane tolerance in units of DBL_EPSILON * coordinate scale
+
+// Triangle of the hull under construction (vertices counterclockwise seen from outside)
+typedef struct {
+    size_t v[3];           // Point indices
+    size_t neighbor[3];    // Face across edge v[i] -> v[(i+1)%3]
+    double nx, ny, nz;     // Unit outward normal
+    size_t outside;        // Head of the outside point list
+    size_t furthest;       // Outside point furthest above the plane
+    double furthest_dist;
+    size_t visit;          // Stamp of the last visibility search that reached this face
+    int visible;           // Result of that search
+    int alive;
+} Face;
+
+// Horizon edge found while removing the faces visible from a new apex
+typedef struct {
+    size_t a, b;     // Edge a -> b as oriented in the visible face
+    size_t outer;    // Surviving face on the other side
+    size_t face;     // New face built on this edge
+} HorizonEdge;
+
+typedef struct {
+    const Point* points;
+    size_t n;
+    Face* faces;
+    size_t face_count;
+    size_t face_capacity;
+    size_t* next;          // Outside-list link per point
+    double eps;
+    ThreadPool* pool;
+} QuickHull;
+
+// Thread arg struct for assigning points to the faces they lie above
+typedef struct {
+    const QuickHull* qh;
+    const size_t* candidates;  // Point indices to assign
+    size_t begin;
+    size_t end;
+    const size_t* faces;       // Face ids to test, in order
+    size_t face_count;
+    size_t* owner;             // Out: face id per candidate, NONE if inside
+    double* dist;              // Out: distance above that face
+} AssignArg;
+
+// Helper: Signed distance of point p above face f
+static double face_distance(const QuickHull* qh, const Face* f, const Point* p) {
+    const Point* a = &qh->points[f->v[0]];
+    return f->nx * ((double)p->x - a->x) + f->ny * ((double)p->y - a->y) + f->nz * ((double)p->z - a->z);
+}
+
+// Helper: Appends a face (a, b, c) with its unit normal; returns its id or NONE on OOM
+static size_t add_face(QuickHull* qh, size_t a, size_t b, size_t c) {
+    if (qh->face_count == qh->face_capacity) {
+        size_t capacity = qh->face_capacity ? qh->face_capacity * 2 : 64;
+        Face* grown = realloc(qh->faces, capacity * sizeof(Face));
+        if (!grown) return NONE;
+        qh->faces = grown;
+        qh->face_capacity = capacity;
+    }
+    Face* f = &qh->faces[qh->face_count];
+    const Point* pa = &qh->points[a];
+    const Point* pb = &qh->points[b];
+    const Point* pc = &qh->points[c];
+    double ux = (double)pb->x - pa->x, uy = (double)pb->y - pa->y, uz = (double)pb->z - pa->z;
+    double wx = (double)pc->x - pa->x, wy = (double)pc->y - pa->y, wz = (double)pc->z - pa->z;
+    double nx = uy * wz - uz * wy;
+    double ny = uz * wx - ux * wz;
+    double nz = ux * wy - uy * wx;
+    double len = sqrt(nx * nx + ny * ny + nz * nz);
+    if (len > 0.0) {
+        nx /= len;
+        ny /= len;
+        nz /= len;
+    }
+    f->v[0] = a;
+    f->v[1] = b;
+    f->v[2] = c;
+    f->neighbor[0] = f->neighbor[1] = f->neighbor[2] = NONE;
+    f->nx = nx;
+    f->ny = ny;
+    f->nz = nz;
+    f->outside = NONE;
+    f->furthest = NONE;
+    f->furthest_dist = 0.0;
+    f->visit = 0;
+    f->visible = 0;
+    f->alive = 1;
+    return qh->face_count++;
+}
+
+// Helper: Pushes point i onto face f's outside list
+static void add_outside(QuickHull* qh, size_t f, size_t i, double dist) {
+    Face* face = &qh->faces[f];
+    qh->next[i] = face->outside;
+    face->outside = i;
+    if (face->furthest == NONE || dist > face->furthest_dist) {
+        face->furthest = i;
+        face->furthest_dist = dist;
+    }
+}
+
+// Task function: finds the first face each candidate point lies above
+static void assign_chunk(void* arg) {
+    AssignArg* a = (AssignArg*)arg;
+    for (size_t k = a->begin; k < a->end; ++k) {
+        const Point* p = &a->qh->points[a->candidates[k]];
+        a->owner[k] = NONE;
+        for (size_t j = 0; j < a->face_count; ++j) {
+            double d = face_distance(a->qh, &a->qh->faces[a->faces[j]], p);
+            if (d > a->qh->eps) {
+                a->owner[k] = a->faces[j];
+                a->dist[k] = d;
+                break;
+            }
+        }
+    }
+}
+
+// Helper: Distributes candidate points over the outside lists of faces (parallel for large batches)
+static int assign_points(QuickHull* qh, const size_t* candidates, size_t count, const size_t* faces, size_t face_count) {
+    if (count == 0) return 0;
+    size_t* owner = malloc(count * sizeof(size_t));
+    double* dist = malloc(count * sizeof(double));
+    size_t workers = thread_pool_parallelism(qh->pool, count);
+    AssignArg* args = malloc(workers * sizeof(AssignArg));
+    if (!owner || !dist || !args) {
+        free(owner); free(dist); free(args);
+        return -1;
+    }
+
+    for (size_t w = 0; w < workers; ++w) {
+        args[w].qh = qh;
+        args[w].candidates = candidates;
+        args[w].begin = count * w / workers;
+        args[w].end = count * (w + 1) / workers;
+        args[w].faces = faces;
+        args[w].face_count = face_count;
+        args[w].owner = owner;
+        args[w].dist = dist;
+    }
+    thread_pool_run(qh->pool, assign_chunk, args, sizeof(AssignArg), workers);
+
+    // Linking is serial: it only touches list heads
+    for (size_t k = 0; k < count; ++k) {
+        if (owner[k] != NONE) add_outside(qh, owner[k], candidates[k], dist[k]);
+    }
+    free(owner); free(dist); free(args);
+    return 0;
+}
+
+// Helper: Builds the initial tetrahedron; returns 0, or -1 if all points are (nearly) coplanar
+static int build_simplex(QuickHull* qh, size_t simplex[4]) {
+    const Point* pts = qh->points;
+    size_t n = qh->n;
+
+    // Extremes along each axis; the widest pair seeds the simplex
+    size_t ext[6] = {0, 0, 0, 0, 0, 0};
+    double scale = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        if (pts[i].x < pts[ext[0]].x) ext[0] = i;
+        if (pts[i].x > pts[ext[1]].x) ext[1] = i;
+        if (pts[i].y < pts[ext[2]].y) ext[2] = i;
+        if (pts[i].y > pts[ext[3]].y) ext[3] = i;
+        if (pts[i].z < pts[ext[4]].z) ext[4] = i;
+        if (pts[i].z > pts[ext[5]].z) ext[5] = i;
+    }
+    scale = fabs(pts[ext[0]].x) + fabs(pts[ext[1]].x) + fabs(pts[ext[2]].y) +
+            fabs(pts[ext[3]].y) + fabs(pts[ext[4]].z) + fabs(pts[ext[5]].z);
+    qh->eps = HULL3D_EPS_FACTOR * DBL_EPSILON * (scale > 0.0 ? scale : 1.0);
+
+    size_t a = ext[0], b = ext[1];
+    double best = -1.0;
+    for (int i = 0; i < 6; i += 2) {
+        const Point* p = &pts[ext[i]];
+        const Point* q = &pts[ext[i + 1]];
+        double dx = (double)q->x - p->x, dy = (double)q->y - p->y, dz = (double)q->z - p->z;
+        double d = dx * dx + dy * dy + dz * dz;
+        if (d > best) {
+            best = d;
+            a = ext[i];
+            b = ext[i + 1];
+        }
+    }
+    if (best <= qh->eps * qh->eps) return -1;
+
+    // Furthest point from line ab
+    double ux = (double)pts[b].x - pts[a].x, uy = (double)pts[b].y - pts[a].y, uz = (double)pts[b].z - pts[a].z;
+    double ulen2 = ux * ux + uy * uy + uz * uz;
+    size_t c = NONE;
+    best = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        double wx = (double)pts[i].x - pts[a].x, wy = (double)pts[i].y - pts[a].y, wz = (double)pts[i].z - pts[a].z;
+        double cx = uy * wz - uz * wy, cy = uz * wx - ux * wz, cz = ux * wy - uy * wx;
+        double d = (cx * cx + cy * cy + cz * cz) / ulen2;
+        if (d > best) {
+            best = d;
+            c = i;
+        }
+    }
+    if (c == NONE || sqrt(best) <= qh->eps) return -1;
+
+    // Furthest point from plane abc
+    size_t base = add_face(qh, a, b, c);
+    if (base == NONE) return -1;
+    size_t d = NONE;
+    best = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        double dist = fabs(face_distance(qh, &qh->faces[base], &pts[i]));
+        if (dist > best) {
+            best = dist;
+            d = i;
+        }
+    }
+    qh->face_count = 0;
+    if (d == NONE || best <= qh->eps) return -1;
+
+    simplex[0] = a;
+    simplex[1] = b;
+    simplex[2] = c;
+    simplex[3] = d;
+
+    // Four faces, each flipped so the opposite vertex lies below it
+    static const int tri[4][4] = {{0, 1, 2, 3}, {0, 1, 3, 2}, {0, 2, 3, 1}, {1, 2, 3, 0}};
+    for (int t = 0; t < 4; ++t) {
+        size_t f = add_face(qh, simplex[tri[t][0]], simplex[tri[t][1]], simplex[tri[t][2]]);
+        if (f == NONE) return -1;
+        if (face_distance(qh, &qh->faces[f], &pts[simplex[tri[t][3]]]) > 0.0) {
+            qh->face_count--;
+            add_face(qh, simplex[tri[t][0]], simplex[tri[t][2]], simplex[tri[t][1]]);
+        }
+    }
+    // Neighbors: the face sharing each edge in reverse
+    for (size_t f = 0; f < 4; ++f) {
+        for (int i = 0; i < 3; ++i) {
+            size_t u = qh->faces[f].v[i], w = qh->faces[f].v[(i + 1) % 3];
+            for (size_t g = 0; g < 4; ++g) {
+                for (int j = 0; j < 3 && g != f; ++j) {
+                    if (qh->faces[g].v[j] == w && qh->faces[g].v[(j + 1) % 3] == u) {
+                        qh->faces[f].neighbor[i] = g;
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// Helper: Orders horizon edges by start vertex for linking new faces
+static int compare_horizon(const void* a, const void* b) {
+    const HorizonEdge* ea = (const HorizonEdge*)a;
+    const HorizonEdge* eb = (const HorizonEdge*)b;
+    return (ea->a > eb->a) - (ea->a < eb->a);
+}
+
+static size_t find_horizon(const HorizonEdge* edges, size_t count, size_t start) {
+    size_t lo = 0, hi = count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (edges[mid].a < start) lo = mid + 1;
+        else hi = mid;
+    }
+    return (lo < count && edges[lo].a == start) ? lo : NONE;
+}
+
+// Growable scratch arrays reused across iterations
+typedef struct {
+    size_t* items;
+    size_t count;
+    size_t capacity;
+} IndexList;
+
+static int list_push(IndexList* list, size_t value) {
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity ? list->capacity * 2 : 64;
+        size_t* grown = realloc(list->items, capacity * sizeof(size_t));
+        if (!grown) return -1;
+        list->items = grown;
+        list->capacity = capacity;
+    }
+    list->items[list->count++] = value;
+    return 0;
+}
+
+// Helper: Adds apex p (furthest point of face start): removes visible faces, cones the horizon to p
+static int add_apex(QuickHull* qh, size_t start, size_t stamp, IndexList* stack, IndexList* visible,
+                    HorizonEdge** horizon, size_t* horizon_capacity, IndexList* orphans, IndexList* new_faces,
+                    IndexList* work) {
+    size_t p = qh->faces[start].furthest;
+    const Point* apex = &qh->points[p];
+    size_t horizon_count = 0;
+
+    // Visible region: connected faces with p strictly above (DFS from start)
+    stack->count = visible->count = 0;
+    qh->faces[start].visit = stamp;
+    qh->faces[start].visible = 1;
+    if (list_push(stack, start) || list_push(visible, start)) return -1;
+    while (stack->count > 0) {
+        size_t g = stack->items[--stack->count];
+        for (int i = 0; i < 3; ++i) {
+            size_t h = qh->faces[g].neighbor[i];
+            Face* fh = &qh->faces[h];
+            if (fh->visit != stamp) {
+                fh->visit = stamp;
+                fh->visible = face_distance(qh, fh, apex) > qh->eps;
+                if (fh->visible && (list_push(stack, h) || list_push(visible, h))) return -1;
+            }
+            if (!fh->visible) {
+                if (horizon_count == *horizon_capacity) {
+                    size_t capacity = *horizon_capacity ? *horizon_capacity * 2 : 64;
+                    HorizonEdge* grown = realloc(*horizon, capacity * sizeof(HorizonEdge));
+                    if (!grown) return -1;
+                    *horizon = grown;
+                    *horizon_capacity = capacity;
+                }
+                HorizonEdge* e = &(*horizon)[horizon_count++];
+                e->a = qh->faces[g].v[i];
+                e->b = qh->faces[g].v[(i + 1) % 3];
+                e->outer = h;
+            }
+        }
+    }
+
+    // Orphaned outside points; the apex itself becomes a vertex
+    orphans->count = 0;
+    for (size_t k = 0; k < visible->count; ++k) {
+        Face* f = &qh->faces[visible->items[k]];
+        for (size_t i = f->outside; i != NONE; i = qh->next[i]) {
+            if (i != p && list_push(orphans, i)) return -1;
+        }
+        f->alive = 0;
+        f->outside = NONE;
+    }
+
+    // Cone from the horizon to p; each new face keeps the horizon edge's orientation
+    new_faces->count = 0;
+    HorizonEdge* edges = *horizon;
+    for (size_t k = 0; k < horizon_count; ++k) {
+        size_t f = add_face(qh, edges[k].a, edges[k].b, p);
+        if (f == NONE || list_push(new_faces, f)) return -1;
+        edges[k].face = f;
+        qh->faces[f].neighbor[0] = edges[k].outer;
+        Face* outer = &qh->faces[edges[k].outer];
+        for (int j = 0; j < 3; ++j) {
+            if (outer->v[j] == edges[k].b && outer->v[(j + 1) % 3] == edges[k].a) {
+                outer->neighbor[j] = f;
+            }
+        }
+    }
+    qsort(edges, horizon_count, sizeof(HorizonEdge), compare_horizon);
+    for (size_t k = 1; k < horizon_count; ++k) {
+        if (edges[k].a == edges[k - 1].a) return -1;  // Pinched horizon: not a simple cycle
+    }
+    for (size_t k = 0; k < horizon_count; ++k) {
+        Face* f = &qh->faces[edges[k].face];
+        // Edge b -> p borders the new face starting at b; edge p -> a borders the one ending at a
+        size_t next = find_horizon(edges, horizon_count, edges[k].b);
+        if (next == NONE) return -1;
+        f->neighbor[1] = edges[next].face;
+        qh->faces[edges[next].face].neighbor[2] = edges[k].face;
+    }
+
+    if (assign_points(qh, orphans->items, orphans->count, new_faces->items, new_faces->count) != 0) {
+        return -1;
+    }
+    for (size_t k = 0; k < new_faces->count; ++k) {
+        if (qh->faces[new_faces->items[k]].outside != NONE && list_push(work, new_faces->items[k])) return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Computes the 3D convex hull of a point set using Quickhull.
+ *
+ * Builds an initial tetrahedron from the axis extremes, assigns every point to a face it lies
+ * above, then repeatedly adds the furthest outside point of a face, replacing the faces it sees
+ * by a cone to the horizon. The initial assignment and large reassignments are split across
+ * threads. Points within a small relative tolerance of a face are treated as on the hull.
+ * @param set Input PointSet (z is used regardless of is_3d).
+ * @param pool Thread pool for point-to-face assignment (NULL runs it on the calling thread).
+ * @return New HullMesh with outward, counterclockwise triangles, or NULL on failure
+ *         (fewer than 4 points or all points coplanar).
+ */
+HullMesh* compute_convex_hull_3d(const PointSet* set, ThreadPool* pool) {
+    if (!set || set->count < 4) {
+        fprintf(stderr, "3D convex hull requires at least 4 points\n");
+        return NULL;
+    }
+
+    QuickHull qh;
+    memset(&qh, 0, sizeof(qh));
+    qh.points = set->points;
+    qh.n = set->count;
+    qh.pool = pool;
+    qh.next = malloc(qh.n * sizeof(size_t));
+    size_t* candidates = malloc(qh.n * sizeof(size_t));
+    IndexList stack = {0}, visible = {0}, orphans = {0}, new_faces = {0}, work = {0};
+    HorizonEdge* horizon = NULL;
+    size_t horizon_capacity = 0;
+    HullMesh* mesh = NULL;
+    size_t* remap = NULL;
+    int failed = 0;
+
+    size_t simplex[4];
+    if (!qh.next || !candidates) {
+        fprintf(stderr, "Memory allocation failed for 3D hull\n");
+        failed = 1;
+    } else if (build_simplex(&qh, simplex) != 0) {
+        fprintf(stderr, "3D convex hull requires points that are not all coplanar\n");
+        failed = 1;
+    }
+
+    if (!failed) {
+        size_t count = 0;
+        for (size_t i = 0; i < qh.n; ++i) {
+            if (i != simplex[0] && i != simplex[1] && i != simplex[2] && i != simplex[3]) {
+                candidates[count++] = i;
+            }
+        }
+        size_t initial[4] = {0, 1, 2, 3};
+        failed = assign_points(&qh, candidates, count, initial, 4) != 0;
+        for (size_t f = 0; f < 4 && !failed; ++f) {
+            if (qh.faces[f].outside != NONE) failed = list_push(&work, f) != 0;
+        }
+    }
+
+    size_t stamp = 0;
+    while (!failed && work.count > 0) {
+        size_t f = work.items[--work.count];
+        if (!qh.faces[f].alive || qh.faces[f].outside == NONE) continue;
+        failed = add_apex(&qh, f, ++stamp, &stack, &visible, &horizon, &horizon_capacity,
+                          &orphans, &new_faces, &work) != 0;
+        if (failed) fprintf(stderr, "3D convex hull construction failed\n");
+    }
+
+    // Compact live faces and the vertices they use
+    if (!failed) {
+        mesh = calloc(1, sizeof(HullMesh));
+        remap = malloc(qh.n * sizeof(size_t));
+        size_t live = 0;
+        for (size_t f = 0; f < qh.face_count; ++f) live += qh.faces[f].alive ? 1 : 0;
+        if (mesh) {
+            mesh->faces = malloc(live * 3 * sizeof(size_t));
+            mesh->vertices = malloc(live * 3 * sizeof(Point));  // Upper bound, shrunk below
+        }
+        if (!mesh || !remap || !mesh->faces || !mesh->vertices) {
+            free_mesh(mesh);
+            mesh = NULL;
+            fprintf(stderr, "Memory allocation failed for 3D hull\n");
+        } else {
+            for (size_t i = 0; i < qh.n; ++i) remap[i] = NONE;
+            for (size_t f = 0; f < qh.face_count; ++f) {
+                if (!qh.faces[f].alive) continue;
+                for (int j = 0; j < 3; ++j) {
+                    size_t v = qh.faces[f].v[j];
+                    if (remap[v] == NONE) {
+                        remap[v] = mesh->vertex_count;
+                        mesh->vertices[mesh->vertex_count++] = qh.points[v];
+                    }
+                    mesh->faces[mesh->face_count * 3 + (size_t)j] = remap[v];
+                }
+                mesh->face_count++;
+            }
+            Point* shrunk = realloc(mesh->vertices, mesh->vertex_count * sizeof(Point));
+            if (shrunk) mesh->vertices = shrunk;
+        }
+    }
+
+    free(remap);
+    free(qh.faces);
+    free(qh.next);
+    free(candidates);
+    free(stack.items);
+    free(visible.items);
+    free(orphans.items);
+    free(new_faces.items);
+    free(work.items);
+    free(horizon);
+    return mesh;
+}
+
+/**
+ * @brief Computes the surface area of a triangle mesh.
+ * @param mesh The HullMesh.
+ * @return Area (float), or -1 on invalid input.
+ */
+float compute_surface_area(const HullMesh* mesh) {
+    if (!mesh || mesh->face_count == 0) return -1.0f;
+
+    double area = 0.0;
+    for (size_t f = 0; f < mesh->face_count; ++f) {
+        const Point* a = &mesh->vertices[mesh->faces[3 * f]];
+        const Point* b = &mesh->vertices[mesh->faces[3 * f + 1]];
+        const Point* c = &mesh->vertices[mesh->faces[3 * f + 2]];
+        double ux = (double)b->x - a->x, uy = (double)b->y - a->y, uz = (double)b->z - a->z;
+        double wx = (double)c->x - a->x, wy = (double)c->y - a->y, wz = (double)c->z - a->z;
+        double nx = uy * wz - uz * wy, ny = uz * wx - ux * wz, nz = ux * wy - uy * wx;
+        area += sqrt(nx * nx + ny * ny + nz * nz);
+    }
+    return (float)(area / 2.0);
+}
+
+/**
+ * @brief Computes the volume enclosed by a closed, outward-oriented triangle mesh.
+ * @param mesh The HullMesh.
+ * @return Volume (float), or -1 on invalid input.
+ */
+float compute_volume(const HullMesh* mesh) {
+    if (!mesh || mesh->face_count == 0) return -1.0f;
+
+    // Signed tetrahedra against the first vertex (keeps magnitudes small at large coordinates)
+    const Point* o = &mesh->vertices[0];
+    double volume = 0.0;
+    for (size_t f = 0; f < mesh->face_count; ++f) {
+        const Point* a = &mesh->vertices[mesh->faces[3 * f]];
+        const Point* b = &mesh->vertices[mesh->faces[3 * f + 1]];
+        const Point* c = &mesh->vertices[mesh->faces[3 * f + 2]];
+        double ax = (double)a->x - o->x, ay = (double)a->y - o->y, az = (double)a->z - o->z;
+        double bx = (double)b->x - o->x, by = (double)b->y - o->y, bz = (double)b->z - o->z;
+        double cx = (double)c->x - o->x, cy = (double)c->y - o->y, cz = (double)c->z - o->z;
+        volume += ax * (by * cz - bz * cy) - ay * (bx * cz - bz * cx) + az * (bx * cy - by * cx);
+    }
+    return (float)(fabs(volume) / 6.0);
+}
+
+/**
+ * @brief Frees memory allocated for a HullMesh.
+ * @param mesh The HullMesh to free.
+ */
+void free_mesh(HullMesh* mesh) {
+    if (mesh) {
+        free(mesh->vertices);
+        free(mesh->faces);
+        free(mesh);
+    }
+}
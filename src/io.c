@@ -1,140 +1,1191 @@
-#include "geometry.h"
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <errno.h>  // For errno and strerror
-#include <ctype.h>  // For tolower in extension check
-
-#define INITIAL_CAPACITY 100  // Starting size for dynamic array
-#define BUFFER_SIZE 256       // For reading lines
-
-// Helper: Check if filename ends with extension (case-insensitive)
-static int ends_with(const char* str, const char* suffix) {
-    size_t str_len = strlen(str);
-    size_t suf_len = strlen(suffix);
-    if (str_len < suf_len) return 0;
-    for (size_t i = 0; i < suf_len; ++i) {
-        if (tolower(str[str_len - suf_len + i]) != tolower(suffix[i])) return 0;
-    }
-    return 1;
-}
-
-/**
- * @brief Loads points from a CSV or OBJ file (format: x,y[,z] per line for CSV; v x y z for OBJ).
- * @param filename Path to the input file.
- * @return Pointer to PointSet on success, NULL on failure.
- */
-PointSet* load_points(const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (!file) {
-        fprintf(stderr, "Error opening file '%s': %s\n", filename, strerror(errno));
-        return NULL;
-    }
-
-    int is_obj = ends_with(filename, ".obj");
-
-    PointSet* set = malloc(sizeof(PointSet));
-    if (!set) {
-        fclose(file);
-        fprintf(stderr, "Memory allocation failed\n");
-        return NULL;
-    }
-
-    set->points = malloc(INITIAL_CAPACITY * sizeof(Point));
-    if (!set->points) {
-        free(set);
-        fclose(file);
-        fprintf(stderr, "Memory allocation failed\n");
-        return NULL;
-    }
-
-    set->count = 0;
-    set->is_3d = 0;  // Assume 2D initially
-    size_t capacity = INITIAL_CAPACITY;
-
-    char buffer[BUFFER_SIZE];
-    while (fgets(buffer, BUFFER_SIZE, file) != NULL) {
-        Point p = {0.0f, 0.0f, 0.0f};
-        int fields;
-        if (is_obj) {
-            // OBJ: skip non-"v" lines
-            if (buffer[0] != 'v' || buffer[1] != ' ') continue;
-            fields = sscanf(buffer + 2, "%f %f %f", &p.x, &p.y, &p.z);  // Parse after "v "
-        } else {
-            // CSV
-            fields = sscanf(buffer, "%f,%f,%f", &p.x, &p.y, &p.z);
-        }
-        if (fields < 2) {
-            // Invalid line: skip
-            continue;
-        }
-        if (fields >= 3 && p.z != 0.0f) {
-            set->is_3d = 1;
-        }
-
-        // Resize if needed
-        if (set->count >= capacity) {
-            capacity *= 2;
-            Point* temp = realloc(set->points, capacity * sizeof(Point));
-            if (!temp) {
-                free_points(set);
-                fclose(file);
-                fprintf(stderr, "Memory reallocation failed\n");
-                return NULL;
-            }
-            set->points = temp;
-        }
-
-        set->points[set->count++] = p;
-    }
-
-    fclose(file);
-    // Shrink to fit
-    if (set->count < capacity) {
-        Point* temp = realloc(set->points, set->count * sizeof(Point));
-        if (temp) set->points = temp;
-    }
-    return set;
-}
-
-/**
- * @brief Saves points to a CSV file (format: x,y[,z] per line).
- * @param set The PointSet to save.
- * @param filename Path to the output CSV file.
- * @return 0 on success, -1 on failure.
- */
-int save_points(const PointSet* set, const char* filename) {
-    if (!set || set->count == 0) {
-        fprintf(stderr, "Invalid PointSet for saving\n");
-        return -1;
-    }
-
-    FILE* file = fopen(filename, "w");
-    if (!file) {
-        fprintf(stderr, "Error opening file '%s' for writing: %s\n", filename, strerror(errno));
-        return -1;
-    }
-
-    for (size_t i = 0; i < set->count; ++i) {
-        const Point* p = &set->points[i];
-        if (set->is_3d) {
-            fprintf(file, "%.2f,%.2f,%.2f\n", p->x, p->y, p->z);  // 2 decimal places
-        } else {
-            fprintf(file, "%.2f,%.2f\n", p->x, p->y);
-        }
-    }
-
-    fclose(file);
-    return 0;
-}
-
-/**
- * @brief Frees memory allocated for a PointSet.
- * @param set The PointSet to free.
- */
-void free_points(PointSet* set) {
-    if (set) {
-        free(set->points);
-        free(set);
-    }
+#define _POSIX_C_SOURCE 200809L  // For mmap, fstat, posix_madvise under -std=c99
+
+#include "geometry.h"
+#include "stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>  // For errno and strerror
+#include <ctype.h>  // For tolower in extension check
+#include <stdint.h>    // For uint64_t mantissa accumulation
+#include <math.h>      // For fabsf in the formatter, nextafterf in the parser
+#include <fcntl.h>     // For open
+#include <unistd.h>    // For close
+#include <sys/mman.h>  // For mmap, munmap, posix_madvise
+#include <sys/stat.h>  // For fstat
+
+#define INITIAL_CAPACITY 100  // Starting size for dynamic array
+#define BUFFER_SIZE 256       // For reading lines
+#define MAX_FAST_DIGITS 19    // Decimal mantissa digits that fit in uint64_t
+#define FALLBACK_TOKEN 64     // Tokens handed to strtof up to this length are copied on the stack
+#define MIN_PARSE_CHUNK (256 * 1024)  // Smallest byte range worth a parser thread
+#define OUTPUT_BUFFER_SIZE (1 << 16)  // Bytes formatted before each write()
+#define MAX_FAST_PRECISION 9          // Decimals handled by the integer formatter
+#define MAX_FORMATTED 64              // Upper bound for one formatted coordinate
+#define BINARY_EXTENSION ".igcb"      // Binary point cloud files
+#define BINARY_MAGIC "IGCB"
+#define BINARY_VERSION 1
+#define BINARY_HEADER_SIZE 32         // Points start 32-byte aligned after the header
+#define BINARY_LAYOUT_F32 0           // Layout id: packed little-endian float32 x,y[,z]
+#define READER_BUFFER_SIZE (1 << 20)  // Initial text window for PointReader (grows for longer lines)
+
+// Growable point buffer filled by the mmap parser
+typedef struct {
+    Point* points;
+    size_t count;
+    size_t capacity;
+    int is_3d;
+    Arena* arena;  // Where points lives (NULL: heap)
+} PointBuffer;
+
+// Incremental reader state: a sliding text window, or a cursor into binary records
+struct PointReader {
+    FILE* file;
+    int is_obj;
+    int is_binary;
+    int is_3d;
+    int eof;
+    int failed;
+    char* buffer;       // Text window [start, len)
+    size_t capacity;
+    size_t start;
+    size_t len;
+    uint32_t dims;      // Binary: coordinates per record
+    uint64_t remaining; // Binary: records left
+};
+
+static PointSet* load_points_binary(const char* filename);
+static PointSet* load_points_stdio(const char* filename);
+static PointSet* load_points_mapped(const char* filename, ThreadPool* pool);
+static int load_buffer(const char* filename, ThreadPool* pool, PointBuffer* buf);
+static int load_binary_buffer(const char* filename, PointBuffer* buf);
+static int save_points_binary(const PointSet* set, const char* filename);
+
+// Helper: Check if filename ends with extension (case-insensitive)
+static int ends_with(const char* str, const char* suffix) {
+    size_t str_len = strlen(str);
+    size_t suf_len = strlen(suffix);
+    if (str_len < suf_len) return 0;
+    for (size_t i = 0; i < suf_len; ++i) {
+        if (tolower(str[str_len - suf_len + i]) != tolower(suffix[i])) return 0;
+    }
+    return 1;
+}
+
+// Helper: realloc for heap point storage, counted in STATS_ALLOCATIONS like the arena's blocks
+static void* heap_resize(void* ptr, size_t bytes) {
+    stats_add(STATS_ALLOCATIONS, 1);
+    return realloc(ptr, bytes > 0 ? bytes : 1);
+}
+
+// Helper: Resizes buf's storage to capacity points, in its arena or on the heap without one
+// (in place when it is the arena's last allocation). Returns 0, or -1 with buf unchanged.
+static int buffer_reserve(PointBuffer* buf, size_t capacity) {
+    Point* resized = buf->arena
+        ? arena_resize(buf->arena, buf->points, buf->capacity * sizeof(Point), capacity * sizeof(Point))
+        : heap_resize(buf->points, capacity * sizeof(Point));
+    if (!resized) return -1;
+    buf->points = resized;
+    buf->capacity = capacity;
+    return 0;
+}
+
+/**
+ * @brief Loads points from a CSV or OBJ file (format: x,y[,z] per line for CSV; v x y z for OBJ).
+ * Files ending in .igcb are read as binary point clouds.
+ * @param filename Path to the input file.
+ * @return Pointer to PointSet on success, NULL on failure.
+ */
+PointSet* load_points(const char* filename) {
+    double phase_start = stats_phase_begin();
+    PointSet* set = ends_with(filename, BINARY_EXTENSION) ? load_points_binary(filename) : load_points_stdio(filename);
+    stats_phase_end(STATS_PHASE_LOAD, phase_start);
+    return set;
+}
+
+// Helper: Line-by-line stdio parser behind load_points (also the fallback for unmappable input)
+static PointSet* load_points_stdio(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Error opening file '%s': %s\n", filename, strerror(errno));
+        return NULL;
+    }
+
+    int is_obj = ends_with(filename, ".obj");
+
+    PointSet* set = malloc(sizeof(PointSet));
+    if (!set) {
+        fclose(file);
+        fprintf(stderr, "Memory allocation failed\n");
+        return NULL;
+    }
+
+    set->points = heap_resize(NULL, INITIAL_CAPACITY * sizeof(Point));
+    if (!set->points) {
+        free(set);
+        fclose(file);
+        fprintf(stderr, "Memory allocation failed\n");
+        return NULL;
+    }
+
+    set->count = 0;
+    set->is_3d = 0;  // Assume 2D initially
+    size_t capacity = INITIAL_CAPACITY;
+    size_t skipped = 0;
+
+    char buffer[BUFFER_SIZE];
+    while (fgets(buffer, BUFFER_SIZE, file) != NULL) {
+        Point p = {0.0f, 0.0f, 0.0f};
+        int fields;
+        if (is_obj) {
+            // OBJ: skip non-"v" lines
+            if (buffer[0] != 'v' || buffer[1] != ' ') {
+                skipped++;
+                continue;
+            }
+            fields = sscanf(buffer + 2, "%f %f %f", &p.x, &p.y, &p.z);  // Parse after "v "
+        } else {
+            // CSV
+            fields = sscanf(buffer, "%f,%f,%f", &p.x, &p.y, &p.z);
+        }
+        if (fields < 2) {
+            // Invalid line: skip
+            skipped++;
+            continue;
+        }
+        if (fields >= 3 && p.z != 0.0f) {
+            set->is_3d = 1;
+        }
+
+        // Resize if needed
+        if (set->count >= capacity) {
+            capacity *= 2;
+            Point* temp = heap_resize(set->points, capacity * sizeof(Point));
+            if (!temp) {
+                free_points(set);
+                fclose(file);
+                fprintf(stderr, "Memory reallocation failed\n");
+                return NULL;
+            }
+            set->points = temp;
+        }
+
+        set->points[set->count++] = p;
+    }
+
+    fclose(file);
+    stats_add(STATS_POINTS_PARSED, set->count);
+    stats_add(STATS_LINES_SKIPPED, skipped);
+    // Shrink to fit
+    if (set->count < capacity) {
+        Point* temp = heap_resize(set->points, set->count * sizeof(Point));
+        if (temp) set->points = temp;
+    }
+    return set;
+}
+
+// Helper: Exact powers of ten representable in double
+static const double POW10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Helper: Same whitespace set as scanf
+static int is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+static const char* skip_spaces(const char* p, const char* end) {
+    while (p < end && is_space(*p)) ++p;
+    return p;
+}
+
+// Helper: Parses spellings the fast paths cannot round exactly (inf, nan, hex, long or extreme
+// decimals) through strtof on a copy of the token; long tokens get a heap copy
+static const char* parse_float_fallback(const char* p, const char* end, float* out) {
+    char small[FALLBACK_TOKEN];
+    size_t len = 0;
+    while (p + len < end && !is_space(p[len]) && p[len] != ',') len++;
+    char* token = len < FALLBACK_TOKEN ? small : malloc(len + 1);
+    if (!token) return NULL;
+    memcpy(token, p, len);
+    token[len] = '\0';
+    char* stop;
+    float value = strtof(token, &stop);
+    size_t used = (size_t)(stop - token);
+    if (token != small) free(token);
+    if (used == 0) return NULL;
+    *out = value;
+    return p + used;
+}
+
+// Helper: True when d lies exactly halfway between value (= (float)d) and its neighbour, where
+// rounding d again could differ from rounding the decimal once
+static int is_float_midpoint(double d, float value) {
+    if ((double)value == d) return 0;
+    float other = nextafterf(value, d > (double)value ? INFINITY : -INFINITY);
+    return d == ((double)value + (double)other) * 0.5;  // Sum of adjacent floats is exact in double
+}
+
+// Helper: Parses a decimal float in [p, end) without copying; returns the position after it or NULL
+static const char* parse_float(const char* p, const char* end, float* out) {
+    const char* start = p;
+    int negative = 0;
+    if (p < end && (*p == '+' || *p == '-')) {
+        negative = (*p == '-');
+        ++p;
+    }
+    if (end - p >= 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+        return parse_float_fallback(start, end, out);  // Hex float, as scanf accepts it
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;      // Significant digits accumulated
+    int exponent = 0;    // Decimal exponent adjustment
+    int seen_digit = 0;
+    int truncated = 0;   // Non-zero digits dropped past MAX_FAST_DIGITS
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (digits < MAX_FAST_DIGITS) {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            if (mantissa) digits++;
+        } else {
+            exponent++;
+            truncated |= (*p != '0');
+        }
+        seen_digit = 1;
+        ++p;
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (digits < MAX_FAST_DIGITS) {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                if (mantissa) digits++;
+                exponent--;
+            } else {
+                truncated |= (*p != '0');
+            }
+            seen_digit = 1;
+            ++p;
+        }
+    }
+    if (!seen_digit) {
+        // inf, nan or hex spellings accepted by scanf
+        return parse_float_fallback(start, end, out);
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        int exp_negative = 0;
+        if (q < end && (*q == '+' || *q == '-')) {
+            exp_negative = (*q == '-');
+            ++q;
+        }
+        if (q < end && *q >= '0' && *q <= '9') {
+            int e = 0;
+            while (q < end && *q >= '0' && *q <= '9') {
+                if (e < 100000) e = e * 10 + (*q - '0');
+                ++q;
+            }
+            exponent += exp_negative ? -e : e;
+            p = q;
+        }
+    }
+
+    float value;
+    if (mantissa == 0) {
+        value = 0.0f;
+    } else if (!truncated && mantissa < (1ULL << 24) && exponent >= -10 && exponent <= 10) {
+        // Mantissa and power of ten are exact in float: one correctly rounded operation
+        value = exponent < 0 ? (float)mantissa / (float)POW10[-exponent]
+                             : (float)mantissa * (float)POW10[exponent];
+    } else if (!truncated && mantissa < (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        // Clinger: exact operands give the correctly rounded double, and narrowing that to float
+        // is exact unless it landed on a float halfway point
+        double d = exponent < 0 ? (double)mantissa / POW10[-exponent] : (double)mantissa * POW10[exponent];
+        value = (float)d;
+        if (is_float_midpoint(d, value)) return parse_float_fallback(start, end, out);
+    } else {
+        // Long mantissas and extreme exponents: let strtof round them
+        return parse_float_fallback(start, end, out);
+    }
+    *out = negative ? -value : value;
+    return p;
+}
+
+// Helper: Parses one line (without its newline) with the same field rules as the sscanf loader
+static int parse_line(const char* p, const char* end, int is_obj, Point* point) {
+    int fields = 0;
+    if (is_obj) {
+        // OBJ: "v x y z"
+        if (end - p < 2 || p[0] != 'v' || p[1] != ' ') return 0;
+        p += 2;
+        float* targets[3] = {&point->x, &point->y, &point->z};
+        for (int f = 0; f < 3; ++f) {
+            p = skip_spaces(p, end);
+            p = parse_float(p, end, targets[f]);
+            if (!p) break;
+            fields++;
+        }
+    } else {
+        // CSV: "x,y[,z]" with optional spaces before each number
+        float* targets[3] = {&point->x, &point->y, &point->z};
+        for (int f = 0; f < 3; ++f) {
+            if (f > 0) {
+                if (p >= end || *p != ',') break;
+                ++p;
+            }
+            p = skip_spaces(p, end);
+            p = parse_float(p, end, targets[f]);
+            if (!p) break;
+            fields++;
+        }
+    }
+    return fields;
+}
+
+// Helper: Appends a point, doubling capacity as needed
+static int buffer_push(PointBuffer* buf, const Point* p) {
+    if (buf->count >= buf->capacity && buffer_reserve(buf, buf->capacity ? buf->capacity * 2 : INITIAL_CAPACITY) != 0) {
+        return -1;
+    }
+    buf->points[buf->count++] = *p;
+    return 0;
+}
+
+// Thread arg struct for parsing one newline-aligned byte range
+typedef struct {
+    const char* begin;
+    const char* end;
+    int is_obj;
+    PointBuffer buf;
+    int status;
+} ParseArg;
+
+// Helper: Parses all complete or trailing lines in [begin, end) into buf
+static int parse_range(const char* begin, const char* end, int is_obj, PointBuffer* buf) {
+    const char* line = begin;
+    size_t parsed = 0, skipped = 0;
+    int status = 0;
+    while (line < end && status == 0) {
+        const char* nl = memchr(line, '\n', (size_t)(end - line));
+        const char* line_end = nl ? nl : end;
+        Point p = {0.0f, 0.0f, 0.0f};
+        int fields = parse_line(line, line_end, is_obj, &p);
+        if (fields >= 2) {
+            if (fields >= 3 && p.z != 0.0f) {
+                buf->is_3d = 1;
+            } else if (fields < 3) {
+                p.z = 0.0f;
+            }
+            status = buffer_push(buf, &p);
+            parsed++;
+        } else {
+            skipped++;
+        }
+        line = line_end + 1;
+    }
+    stats_add(STATS_POINTS_PARSED, parsed);
+    stats_add(STATS_LINES_SKIPPED, skipped);
+    return status;
+}
+
+// Helper: Grows buf to the capacity a text range of size bytes is likely to need (~16 bytes per
+// CSV line); on failure parse_range still grows it point by point
+static void reserve_for_text(PointBuffer* buf, size_t size) {
+    size_t estimate = size / 16 + INITIAL_CAPACITY;
+    if (buf->capacity < estimate) buffer_reserve(buf, estimate);
+}
+
+// Pool task: parses one range into a private buffer
+static void parse_chunk(void* arg) {
+    ParseArg* a = (ParseArg*)arg;
+    reserve_for_text(&a->buf, (size_t)(a->end - a->begin));
+    a->status = parse_range(a->begin, a->end, a->is_obj, &a->buf);
+}
+
+// Helper: Start of the first line beginning at or after offset
+static size_t align_to_line(const char* data, size_t size, size_t offset) {
+    if (offset == 0 || offset >= size) return offset < size ? offset : size;
+    if (data[offset - 1] == '\n') return offset;
+    const char* nl = memchr(data + offset, '\n', size - offset);
+    return nl ? (size_t)(nl - data) + 1 : size;
+}
+
+// Helper: Parses mapped text into buf, splitting it into newline-aligned ranges on the pool when
+// it is large enough. Ranges are appended to buf in file order; 3D if any range saw a non-zero z.
+static int parse_mapped(const char* data, size_t size, int is_obj, ThreadPool* pool, PointBuffer* buf) {
+    size_t workers = thread_pool_size(pool);
+    if (workers > size / MIN_PARSE_CHUNK + 1) workers = size / MIN_PARSE_CHUNK + 1;
+    if (workers == 1) {
+        // Small input or no pool: parse straight into buf on the calling thread
+        reserve_for_text(buf, size);
+        return parse_range(data, data + size, is_obj, buf);
+    }
+
+    ParseArg* args = calloc(workers, sizeof(ParseArg));
+    if (!args) return -1;
+
+    // Newline-aligned ranges; a worker may get an empty range if lines are very long
+    size_t prev = 0;
+    for (size_t w = 0; w < workers; ++w) {
+        size_t stop = (w + 1 == workers) ? size : align_to_line(data, size, size * (w + 1) / workers);
+        if (stop < prev) stop = prev;
+        args[w].begin = data + prev;
+        args[w].end = data + stop;
+        args[w].is_obj = is_obj;
+        prev = stop;
+    }
+    thread_pool_run(pool, parse_chunk, args, sizeof(ParseArg), workers);
+
+    int status = 0;
+    size_t total = buf->count;
+    for (size_t w = 0; w < workers; ++w) {
+        if (args[w].status != 0) status = -1;
+        total += args[w].buf.count;
+        buf->is_3d |= args[w].buf.is_3d;
+    }
+    if (status == 0 && total > buf->capacity) status = buffer_reserve(buf, total);
+    for (size_t w = 0; w < workers; ++w) {
+        if (status == 0) {
+            memcpy(buf->points + buf->count, args[w].buf.points, args[w].buf.count * sizeof(Point));
+            buf->count += args[w].buf.count;
+        }
+        free(args[w].buf.points);
+    }
+    free(args);
+    return status;
+}
+
+/**
+ * @brief Loads points from a CSV or OBJ file by memory-mapping it and parsing in place.
+ *
+ * Numbers are parsed straight from the mapped bytes with a hand-written float parser, so
+ * there is no per-line copy and no line length limit. The file is split into newline-aligned
+ * byte ranges parsed concurrently on the pool, then concatenated in file order. Field rules
+ * match load_points: 2 or 3 fields, invalid lines skipped, 3D when any z is non-zero. Falls
+ * back to load_points when the file cannot be mapped.
+ * @param filename Path to the input file.
+ * @param pool Threads for the parser ranges (NULL: serial; small files use fewer).
+ * @return Pointer to PointSet on success, NULL on failure.
+ */
+PointSet* load_points_mmap(const char* filename, ThreadPool* pool) {
+    double phase_start = stats_phase_begin();
+    PointSet* set = ends_with(filename, BINARY_EXTENSION) ? load_points_binary(filename)
+                                                          : load_points_mapped(filename, pool);
+    stats_phase_end(STATS_PHASE_LOAD, phase_start);
+    return set;
+}
+
+// Helper: Maps a text file and parses it in place (stdio fallback when it cannot be mapped)
+static PointSet* load_points_mapped(const char* filename, ThreadPool* pool) {
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error opening file '%s': %s\n", filename, strerror(errno));
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return load_points_stdio(filename);
+    }
+
+    size_t size = (size_t)st.st_size;
+    const char* data = "";
+    if (size > 0) {
+        void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            close(fd);
+            return load_points_stdio(filename);
+        }
+        posix_madvise(map, size, POSIX_MADV_SEQUENTIAL);
+        data = (const char*)map;
+    }
+    close(fd);
+
+    PointBuffer buf = {NULL, 0, 0, 0, NULL};
+    int status = parse_mapped(data, size, ends_with(filename, ".obj"), pool, &buf);
+    if (size > 0) munmap((void*)data, size);
+    PointSet* set = status == 0 ? malloc(sizeof(PointSet)) : NULL;
+    if (!set) {
+        free(buf.points);
+        fprintf(stderr, "Memory allocation failed\n");
+        return NULL;
+    }
+    if (buf.count > 0 && buf.count < buf.capacity) {
+        // Shrink to fit
+        Point* temp = heap_resize(buf.points, buf.count * sizeof(Point));
+        if (temp) buf.points = temp;
+    }
+    set->points = buf.points;
+    set->count = buf.count;
+    set->is_3d = buf.is_3d;
+    return set;
+}
+
+/**
+ * @brief Loads a CSV, OBJ or .igcb file into caller-owned storage, reusing it across calls.
+ *
+ * set->points must be NULL or a malloc'd array with room for *capacity points. It is grown
+ * with realloc when a file needs more room and never shrunk, so a long-lived set stops
+ * allocating once it has seen the largest file. Text is parsed from a private mapping, in
+ * ranges on the pool like load_points_mmap when one is given (callers such as batch mode that
+ * load several files concurrently pass NULL and parse on the calling thread).
+ * @param filename Path to the input file.
+ * @param set Destination; count and is_3d are overwritten.
+ * @param capacity In/out: allocated size of set->points, in points.
+ * @param pool Threads for the parser ranges (NULL: calling thread).
+ * @return 0 on success, -1 on failure (set->points stays valid and owned by the caller).
+ */
+int load_points_into(const char* filename, PointSet* set, size_t* capacity, ThreadPool* pool) {
+    double phase_start = stats_phase_begin();
+    PointBuffer buf = {set->points, 0, set->points ? *capacity : 0, 0, NULL};
+    int status = load_buffer(filename, pool, &buf);
+    set->points = buf.points;
+    *capacity = buf.capacity;
+    set->count = status == 0 ? buf.count : 0;
+    set->is_3d = buf.is_3d;
+    stats_phase_end(STATS_PHASE_LOAD, phase_start);
+    return status;
+}
+
+/**
+ * @brief Loads a CSV, OBJ or .igcb file into arena memory.
+ *
+ * The point array is the arena's newest allocation while it is filled, so it grows in place
+ * instead of being copied, and is trimmed to the point count at the end. A caller that resets
+ * the arena between files makes no heap allocations once the arena has grown to the largest
+ * file. Text is parsed on the calling thread, as in load_points_into.
+ * @param filename Path to the input file.
+ * @param arena Arena for the PointSet and its points (NULL: heap, free with free_points).
+ * @return Pointer to PointSet on success, NULL on failure.
+ */
+PointSet* load_points_arena(const char* filename, Arena* arena) {
+    double phase_start = stats_phase_begin();
+    PointSet* set = arena_alloc(arena, sizeof(PointSet));
+    if (!set) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return NULL;
+    }
+    PointBuffer buf = {NULL, 0, 0, 0, arena};
+    if (load_buffer(filename, NULL, &buf) != 0) {
+        arena_free(arena, buf.points);
+        arena_free(arena, set);
+        return NULL;
+    }
+    if (buf.count < buf.capacity) {
+        Point* trimmed = arena_resize(arena, buf.points, buf.capacity * sizeof(Point), buf.count * sizeof(Point));
+        if (trimmed) buf.points = trimmed;
+    }
+    set->points = buf.points;
+    set->count = buf.count;
+    set->is_3d = buf.is_3d;
+    stats_phase_end(STATS_PHASE_LOAD, phase_start);
+    return set;
+}
+
+// Helper: Loads a file into buf, parsing text on the pool (buf->points may already hold storage)
+static int load_buffer(const char* filename, ThreadPool* pool, PointBuffer* buf) {
+    int status = 0;
+    if (ends_with(filename, BINARY_EXTENSION)) {
+        status = load_binary_buffer(filename, buf);
+    } else {
+        int fd = open(filename, O_RDONLY);
+        if (fd < 0) {
+            fprintf(stderr, "Error opening file '%s': %s\n", filename, strerror(errno));
+            return -1;
+        }
+        struct stat st;
+        int regular = fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+        size_t size = regular ? (size_t)st.st_size : 0;
+        void* map = size > 0 ? mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        close(fd);
+
+        if (map != MAP_FAILED) {
+            posix_madvise(map, size, POSIX_MADV_SEQUENTIAL);
+            status = parse_mapped((const char*)map, size, ends_with(filename, ".obj"), pool, buf);
+            munmap(map, size);
+            if (status != 0) fprintf(stderr, "Memory allocation failed\n");
+        } else if (!regular || size > 0) {
+            // Not mappable (e.g. a pipe): parse with stdio and copy into the reused storage
+            PointSet* loaded = load_points_stdio(filename);
+            if (!loaded) return -1;
+            for (size_t i = 0; i < loaded->count && status == 0; ++i) {
+                status = buffer_push(buf, &loaded->points[i]);
+            }
+            buf->is_3d = loaded->is_3d;
+            free_points(loaded);
+            if (status != 0) fprintf(stderr, "Memory allocation failed\n");
+        }
+    }
+    return status;
+}
+
+// Helper: Powers of ten for the fixed-point formatter
+static const uint64_t POW10_U64[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL
+};
+
+// Helper: Formats value like printf("%.*f") into out and returns the length.
+// Works on the exact binary value (m * 2^e) with round-half-even, so the digits are
+// byte-identical to glibc's; huge magnitudes, inf/nan and high precisions use snprintf.
+static size_t format_fixed(char* out, float value, int precision) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint32_t exp_bits = (bits >> 23) & 0xFF;
+    if (exp_bits == 0xFF || precision < 0 || precision > MAX_FAST_PRECISION || fabsf(value) >= 2147483648.0f) {
+        int len = snprintf(out, MAX_FORMATTED, "%.*f", precision, value);
+        return len < 0 ? 0 : (len >= MAX_FORMATTED ? MAX_FORMATTED - 1 : (size_t)len);
+    }
+
+    uint64_t m = bits & 0x7FFFFF;
+    int e = -149;
+    if (exp_bits != 0) {
+        m |= 0x800000;
+        e = (int)exp_bits - 150;
+    }
+
+    // scaled = round(|value| * 10^precision); |value| < 2^31 keeps every product below 2^64
+    uint64_t p10 = POW10_U64[precision];
+    uint64_t scaled;
+    if (e >= 0) {
+        scaled = (m << e) * p10;
+    } else if (-e >= 64) {
+        scaled = 0;  // Below half a unit in the last place for any precision <= 9
+    } else {
+        int k = -e;
+        uint64_t num = m * p10;
+        uint64_t q = num >> k;
+        uint64_t r = num & ((1ULL << k) - 1);
+        uint64_t half = 1ULL << (k - 1);
+        if (r > half || (r == half && (q & 1))) q++;
+        scaled = q;
+    }
+
+    char* p = out;
+    if (bits >> 31) *p++ = '-';  // printf keeps the sign of negative values that round to zero
+
+    char digits[24];
+    size_t n = 0;
+    uint64_t int_part = scaled / p10;
+    do {
+        digits[n++] = (char)('0' + int_part % 10);
+        int_part /= 10;
+    } while (int_part);
+    while (n) *p++ = digits[--n];
+
+    if (precision > 0) {
+        *p++ = '.';
+        uint64_t frac = scaled % p10;
+        for (int d = precision - 1; d >= 0; --d) {
+            p[d] = (char)('0' + frac % 10);
+            frac /= 10;
+        }
+        p += precision;
+    }
+    return (size_t)(p - out);
+}
+
+// Helper: Writes all bytes, retrying on partial writes and EINTR
+static int write_all(int fd, const char* data, size_t len) {
+    size_t total = len;
+    while (len > 0) {
+        ssize_t written = write(fd, data, len);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            stats_add(STATS_BYTES_WRITTEN, total - len);
+            return -1;
+        }
+        data += written;
+        len -= (size_t)written;
+    }
+    stats_add(STATS_BYTES_WRITTEN, total);
+    return 0;
+}
+
+// Helper: 1 on little-endian hosts, where binary payloads need no byte swapping
+static int host_is_little_endian(void) {
+    uint16_t one = 1;
+    unsigned char first;
+    memcpy(&first, &one, 1);
+    return first == 1;
+}
+
+static void put_u32le(unsigned char* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static void put_u64le(unsigned char* p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static uint32_t get_u32le(const unsigned char* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint64_t get_u64le(const unsigned char* p) {
+    return (uint64_t)get_u32le(p) | (uint64_t)get_u32le(p + 4) << 32;
+}
+
+// Helper: Little-endian float32 <-> host float
+static float get_f32le(const unsigned char* p) {
+    uint32_t bits = get_u32le(p);
+    float v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+static void put_f32le(unsigned char* p, float v) {
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    put_u32le(p, bits);
+}
+
+// Binary layout (all little-endian):
+//   0  char[4] magic "IGCB"     4  u32 version        8  u64 point count
+//  16  u32 dimension (2 or 3)  20  u32 point stride  24  u32 layout id   28  u32 reserved
+//  32  count * stride bytes of float32 coordinates (x, y[, z])
+static int load_binary_buffer(const char* filename, PointBuffer* buf) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error opening file '%s': %s\n", filename, strerror(errno));
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < BINARY_HEADER_SIZE) {
+        close(fd);
+        fprintf(stderr, "Invalid binary point file '%s'\n", filename);
+        return -1;
+    }
+    size_t size = (size_t)st.st_size;
+    void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "Error mapping file '%s': %s\n", filename, strerror(errno));
+        return -1;
+    }
+    posix_madvise(map, size, POSIX_MADV_SEQUENTIAL);
+
+    const unsigned char* data = (const unsigned char*)map;
+    uint64_t count = get_u64le(data + 8);
+    uint32_t dims = get_u32le(data + 16);
+    uint32_t stride = get_u32le(data + 20);
+    if (memcmp(data, BINARY_MAGIC, 4) != 0 || get_u32le(data + 4) != BINARY_VERSION ||
+        (dims != 2 && dims != 3) || stride != dims * sizeof(float) ||
+        get_u32le(data + 24) != BINARY_LAYOUT_F32 ||
+        count > (size - BINARY_HEADER_SIZE) / stride) {
+        munmap(map, size);
+        fprintf(stderr, "Invalid binary point file '%s'\n", filename);
+        return -1;
+    }
+
+    if (buf->capacity < count || !buf->points) {
+        if (buffer_reserve(buf, count > 0 ? (size_t)count : 1) != 0) {
+            munmap(map, size);
+            fprintf(stderr, "Memory allocation failed\n");
+            return -1;
+        }
+    }
+    Point* points = buf->points;
+
+    const unsigned char* payload = data + BINARY_HEADER_SIZE;
+    if (dims == 3 && sizeof(Point) == 3 * sizeof(float) && host_is_little_endian()) {
+        memcpy(points, payload, (size_t)count * sizeof(Point));  // Same layout: straight copy
+    } else if (host_is_little_endian()) {
+        const float* src = (const float*)(const void*)payload;  // Header keeps payload 4-byte aligned
+        for (size_t i = 0; i < count; ++i) {
+            points[i].x = src[i * dims];
+            points[i].y = src[i * dims + 1];
+            points[i].z = dims == 3 ? src[i * dims + 2] : 0.0f;
+        }
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            const unsigned char* p = payload + i * stride;
+            points[i].x = get_f32le(p);
+            points[i].y = get_f32le(p + 4);
+            points[i].z = dims == 3 ? get_f32le(p + 8) : 0.0f;
+        }
+    }
+    munmap(map, size);
+    stats_add(STATS_POINTS_PARSED, count);
+
+    buf->count = (size_t)count;
+    buf->is_3d = (dims == 3);
+    return 0;
+}
+
+static PointSet* load_points_binary(const char* filename) {
+    PointBuffer buf = {NULL, 0, 0, 0, NULL};
+    if (load_binary_buffer(filename, &buf) != 0) return NULL;
+    PointSet* set = malloc(sizeof(PointSet));
+    if (!set) {
+        free(buf.points);
+        fprintf(stderr, "Memory allocation failed\n");
+        return NULL;
+    }
+    set->points = buf.points;
+    set->count = buf.count;
+    set->is_3d = buf.is_3d;
+    return set;
+}
+
+// Helper: Writes the binary header plus raw coordinates (3D sets go out in a single write)
+static int save_points_binary(const PointSet* set, const char* filename) {
+    int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "Error opening file '%s' for writing: %s\n", filename, strerror(errno));
+        return -1;
+    }
+
+    uint32_t dims = set->is_3d ? 3 : 2;
+    unsigned char header[BINARY_HEADER_SIZE] = {0};
+    memcpy(header, BINARY_MAGIC, 4);
+    put_u32le(header + 4, BINARY_VERSION);
+    put_u64le(header + 8, (uint64_t)set->count);
+    put_u32le(header + 16, dims);
+    put_u32le(header + 20, dims * (uint32_t)sizeof(float));
+    put_u32le(header + 24, BINARY_LAYOUT_F32);
+    int status = write_all(fd, (const char*)header, sizeof(header));
+
+    if (status == 0 && dims == 3 && sizeof(Point) == 3 * sizeof(float) && host_is_little_endian()) {
+        status = write_all(fd, (const char*)set->points, set->count * sizeof(Point));
+    } else if (status == 0) {
+        unsigned char buffer[OUTPUT_BUFFER_SIZE];
+        size_t used = 0;
+        for (size_t i = 0; i < set->count && status == 0; ++i) {
+            if (OUTPUT_BUFFER_SIZE - used < 3 * sizeof(float)) {
+                status = write_all(fd, (const char*)buffer, used);
+                used = 0;
+            }
+            put_f32le(buffer + used, set->points[i].x);
+            put_f32le(buffer + used + 4, set->points[i].y);
+            if (dims == 3) put_f32le(buffer + used + 8, set->points[i].z);
+            used += dims * sizeof(float);
+        }
+        if (status == 0 && used > 0) {
+            status = write_all(fd, (const char*)buffer, used);
+        }
+    }
+    if (status != 0) {
+        fprintf(stderr, "Error writing file '%s': %s\n", filename, strerror(errno));
+    }
+    if (close(fd) != 0 && status == 0) {
+        fprintf(stderr, "Error closing file '%s': %s\n", filename, strerror(errno));
+        status = -1;
+    }
+    return status;
+}
+
+/**
+ * @brief Opens a CSV, OBJ or .igcb file for block-by-block reading.
+ *
+ * Memory use is bounded by the read window (1 MB, grown only for longer lines) plus the
+ * caller's output block. Text lines follow the same field rules as load_points_mmap.
+ * @param filename Path to the input file.
+ * @return Reader on success, NULL on failure.
+ */
+PointReader* point_reader_open(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        fprintf(stderr, "Error opening file '%s': %s\n", filename, strerror(errno));
+        return NULL;
+    }
+    PointReader* reader = calloc(1, sizeof(PointReader));
+    if (!reader) {
+        fclose(file);
+        fprintf(stderr, "Memory allocation failed\n");
+        return NULL;
+    }
+    reader->file = file;
+    reader->is_obj = ends_with(filename, ".obj");
+    reader->is_binary = ends_with(filename, BINARY_EXTENSION);
+
+    if (reader->is_binary) {
+        unsigned char header[BINARY_HEADER_SIZE];
+        if (fread(header, 1, sizeof(header), file) != sizeof(header) ||
+            memcmp(header, BINARY_MAGIC, 4) != 0 || get_u32le(header + 4) != BINARY_VERSION ||
+            get_u32le(header + 24) != BINARY_LAYOUT_F32 ||
+            (get_u32le(header + 16) != 2 && get_u32le(header + 16) != 3) ||
+            get_u32le(header + 20) != get_u32le(header + 16) * sizeof(float)) {
+            fprintf(stderr, "Invalid binary point file '%s'\n", filename);
+            point_reader_close(reader);
+            return NULL;
+        }
+        reader->dims = get_u32le(header + 16);
+        reader->remaining = get_u64le(header + 8);
+        reader->is_3d = (reader->dims == 3);
+        return reader;
+    }
+
+    reader->capacity = READER_BUFFER_SIZE;
+    reader->buffer = malloc(reader->capacity);
+    if (!reader->buffer) {
+        fprintf(stderr, "Memory allocation failed\n");
+        point_reader_close(reader);
+        return NULL;
+    }
+    return reader;
+}
+
+// Helper: Reads up to max_points binary records
+static size_t reader_read_binary(PointReader* reader, Point* out, size_t max_points) {
+    unsigned char record[3 * sizeof(float)];
+    size_t stride = reader->dims * sizeof(float);
+    size_t count = 0;
+    while (count < max_points && reader->remaining > 0) {
+        if (fread(record, 1, stride, reader->file) != stride) {
+            reader->failed = 1;
+            reader->remaining = 0;
+            break;
+        }
+        out[count].x = get_f32le(record);
+        out[count].y = get_f32le(record + 4);
+        out[count].z = reader->dims == 3 ? get_f32le(record + 8) : 0.0f;
+        count++;
+        reader->remaining--;
+    }
+    stats_add(STATS_POINTS_PARSED, count);
+    return count;
+}
+
+// Helper: Refills the text window, keeping the unparsed tail; returns 0 when nothing was added
+static int reader_refill(PointReader* reader) {
+    if (reader->eof) return 0;
+    size_t tail = reader->len - reader->start;
+    memmove(reader->buffer, reader->buffer + reader->start, tail);
+    reader->start = 0;
+    reader->len = tail;
+    if (reader->len == reader->capacity) {
+        // A single line fills the window: grow it rather than split the line
+        char* grown = realloc(reader->buffer, reader->capacity * 2);
+        if (!grown) {
+            reader->failed = 1;
+            return 0;
+        }
+        reader->buffer = grown;
+        reader->capacity *= 2;
+    }
+    size_t got = fread(reader->buffer + reader->len, 1, reader->capacity - reader->len, reader->file);
+    if (got == 0) {
+        if (ferror(reader->file)) reader->failed = 1;
+        reader->eof = 1;
+        return 0;
+    }
+    reader->len += got;
+    return 1;
+}
+
+/**
+ * @brief Reads the next block of points.
+ * @param reader Reader from point_reader_open.
+ * @param out Destination for up to max_points points.
+ * @param max_points Block size.
+ * @return Number of points read; 0 at end of input (check point_reader_failed for errors).
+ */
+size_t point_reader_read(PointReader* reader, Point* out, size_t max_points) {
+    if (!reader || !out || max_points == 0) return 0;
+    double phase_start = stats_phase_begin();
+    if (reader->is_binary) {
+        size_t count = reader_read_binary(reader, out, max_points);
+        stats_phase_end(STATS_PHASE_LOAD, phase_start);
+        return count;
+    }
+
+    size_t count = 0, skipped = 0;
+    while (count < max_points) {
+        const char* line = reader->buffer + reader->start;
+        const char* end = reader->buffer + reader->len;
+        const char* nl = memchr(line, '\n', (size_t)(end - line));
+        if (!nl) {
+            if (reader_refill(reader)) continue;
+            if (reader->failed || reader->start == reader->len) break;
+            nl = end;  // Final line without a trailing newline
+        }
+        Point p = {0.0f, 0.0f, 0.0f};
+        int fields = parse_line(line, nl, reader->is_obj, &p);
+        reader->start = (size_t)(nl - reader->buffer) + (nl < end ? 1 : 0);
+        if (fields >= 2) {
+            if (fields >= 3 && p.z != 0.0f) {
+                reader->is_3d = 1;
+            } else if (fields < 3) {
+                p.z = 0.0f;
+            }
+            out[count++] = p;
+        } else {
+            skipped++;
+        }
+    }
+    stats_add(STATS_POINTS_PARSED, count);
+    stats_add(STATS_LINES_SKIPPED, skipped);
+    stats_phase_end(STATS_PHASE_LOAD, phase_start);
+    return count;
+}
+
+/**
+ * @brief Reports whether any point read so far had a non-zero z (or the file is 3D binary).
+ */
+int point_reader_is_3d(const PointReader* reader) {
+    return reader ? reader->is_3d : 0;
+}
+
+/**
+ * @brief Reports whether a read error occurred.
+ */
+int point_reader_failed(const PointReader* reader) {
+    return reader ? reader->failed : 1;
+}
+
+/**
+ * @brief Closes the reader and frees its buffers.
+ * @param reader The reader to close (NULL is ignored).
+ */
+void point_reader_close(PointReader* reader) {
+    if (reader) {
+        if (reader->file) fclose(reader->file);
+        free(reader->buffer);
+        free(reader);
+    }
+}
+
+/**
+ * @brief Saves points to a CSV file (format: x,y[,z] per line).
+ *
+ * Files ending in .igcb are written in the binary point cloud format instead (precision is
+ * ignored). Coordinates are formatted by a fixed-precision integer formatter into a 64 KB
+ * stack buffer that is flushed with one write() per block, so saving allocates nothing.
+ * Output is byte-identical to fprintf("%.*f").
+ * @param set The PointSet to save.
+ * @param filename Path to the output CSV file.
+ * @param precision Decimal places per coordinate (2 matches the historical format).
+ * @return 0 on success, -1 on failure.
+ */
+int save_points(const PointSet* set, const char* filename, int precision) {
+    if (!set || set->count == 0) {
+        fprintf(stderr, "Invalid PointSet for saving\n");
+        return -1;
+    }
+    double phase_start = stats_phase_begin();
+    if (ends_with(filename, BINARY_EXTENSION)) {
+        int status = save_points_binary(set, filename);
+        stats_phase_end(STATS_PHASE_WRITE, phase_start);
+        return status;
+    }
+
+    int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "Error opening file '%s' for writing: %s\n", filename, strerror(errno));
+        return -1;
+    }
+
+    char buffer[OUTPUT_BUFFER_SIZE];  // Stack buffer: only threads that write pay for it
+
+    int status = 0;
+    size_t used = 0;
+    for (size_t i = 0; i < set->count && status == 0; ++i) {
+        const Point* p = &set->points[i];
+        if (OUTPUT_BUFFER_SIZE - used < 3 * (MAX_FORMATTED + 1)) {
+            status = write_all(fd, buffer, used);
+            used = 0;
+        }
+        used += format_fixed(buffer + used, p->x, precision);
+        buffer[used++] = ',';
+        used += format_fixed(buffer + used, p->y, precision);
+        if (set->is_3d) {
+            buffer[used++] = ',';
+            used += format_fixed(buffer + used, p->z, precision);
+        }
+        buffer[used++] = '\n';
+    }
+    if (status == 0 && used > 0) {
+        status = write_all(fd, buffer, used);
+    }
+    if (status != 0) {
+        fprintf(stderr, "Error writing file '%s': %s\n", filename, strerror(errno));
+    }
+
+    if (close(fd) != 0 && status == 0) {
+        fprintf(stderr, "Error closing file '%s': %s\n", filename, strerror(errno));
+        status = -1;
+    }
+    stats_phase_end(STATS_PHASE_WRITE, phase_start);
+    return status;
+}
+
+/**
+ * @brief Saves a hull mesh: OBJ ("v" and 1-based "f" lines) when the name ends in .obj,
+ * otherwise just its vertices via save_points.
+ * @param mesh The HullMesh to save.
+ * @param filename Path to the output file.
+ * @param precision Decimal places per coordinate.
+ * @return 0 on success, -1 on failure.
+ */
+int save_mesh(const HullMesh* mesh, const char* filename, int precision) {
+    if (!mesh || mesh->vertex_count == 0) {
+        fprintf(stderr, "Invalid HullMesh for saving\n");
+        return -1;
+    }
+    if (!ends_with(filename, ".obj")) {
+        PointSet vertices = {mesh->vertices, mesh->vertex_count, 1};
+        return save_points(&vertices, filename, precision);
+    }
+
+    double phase_start = stats_phase_begin();
+    int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "Error opening file '%s' for writing: %s\n", filename, strerror(errno));
+        return -1;
+    }
+    char buffer[OUTPUT_BUFFER_SIZE];
+
+    int status = 0;
+    size_t used = 0;
+    for (size_t i = 0; i < mesh->vertex_count && status == 0; ++i) {
+        const Point* p = &mesh->vertices[i];
+        if (OUTPUT_BUFFER_SIZE - used < 3 * (MAX_FORMATTED + 1) + 2) {
+            status = write_all(fd, buffer, used);
+            used = 0;
+        }
+        buffer[used++] = 'v';
+        buffer[used++] = ' ';
+        used += format_fixed(buffer + used, p->x, precision);
+        buffer[used++] = ' ';
+        used += format_fixed(buffer + used, p->y, precision);
+        buffer[used++] = ' ';
+        used += format_fixed(buffer + used, p->z, precision);
+        buffer[used++] = '\n';
+    }
+    for (size_t f = 0; f < mesh->face_count && status == 0; ++f) {
+        if (OUTPUT_BUFFER_SIZE - used < 3 * 24 + 3) {
+            status = write_all(fd, buffer, used);
+            used = 0;
+        }
+        int len = snprintf(buffer + used, OUTPUT_BUFFER_SIZE - used, "f %zu %zu %zu\n",
+                           mesh->faces[3 * f] + 1, mesh->faces[3 * f + 1] + 1, mesh->faces[3 * f + 2] + 1);
+        used += len > 0 ? (size_t)len : 0;
+    }
+    if (status == 0 && used > 0) {
+        status = write_all(fd, buffer, used);
+    }
+    if (status != 0) {
+        fprintf(stderr, "Error writing file '%s': %s\n", filename, strerror(errno));
+    }
+
+    if (close(fd) != 0 && status == 0) {
+        fprintf(stderr, "Error closing file '%s': %s\n", filename, strerror(errno));
+        status = -1;
+    }
+    stats_phase_end(STATS_PHASE_WRITE, phase_start);
+    return status;
+}
+
+/**
+ * @brief Frees memory allocated for a PointSet.
+ * @param set The PointSet to free.
+ */
+void free_points(PointSet* set) {
+    if (set) {
+        free(set->points);
+        free(set);
+    }
 }
\ No newline at end of file
@@ -1,139 +1,611 @@
-#include "geometry.h"
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <time.h>  // For clock() timing
-
-/**
- * @brief Prints usage information.
- */
-static void print_usage(const char* progname) {
-    fprintf(stderr, "Usage: %s input.csv|input.obj output.csv [--mode hull] [--dim 2|3] [--threads N] [--benchmark]\n", progname);
-    fprintf(stderr, "  Supports CSV (x,y[,z]) or OBJ (v x y z) input.\n");
-    fprintf(stderr, "  --mode hull: Compute convex hull (default)\n");
-    fprintf(stderr, "  --dim 2|3: Force 2D or 3D mode (default: auto-detect)\n");
-    fprintf(stderr, "  --threads N: Number of threads for computation (default: 1)\n");
-    fprintf(stderr, "  --benchmark: Run performance benchmarks (ignores input/output files)\n");
-}
-
-// Simple function to generate synthetic points for benchmarking
-static PointSet* generate_synthetic_points(size_t count, int is_3d) {
-    PointSet* set = malloc(sizeof(PointSet));
-    set->points = malloc(count * sizeof(Point));
-    set->count = count;
-    set->is_3d = is_3d;
-    for (size_t i = 0; i < count; ++i) {
-        set->points[i].x = (float)rand() / RAND_MAX * 100.0f;
-        set->points[i].y = (float)rand() / RAND_MAX * 100.0f;
-        set->points[i].z = is_3d ? (float)rand() / RAND_MAX * 100.0f : 0.0f;
-    }
-    return set;
-}
-
-int main(int argc, char** argv) {
-    if (argc < 3) {
-        print_usage(argv[0]);
-        return 1;
-    }
-
-    const char* input_file = argv[1];
-    const char* output_file = argv[2];
-    char* mode = "hull";  // Default mode
-    int forced_dim = -1;  // -1: auto, 2: force 2D, 3: force 3D
-    int num_threads = 1;  // Default threads
-    int benchmark = 0;    // Flag for benchmark mode
-
-    // Simple CLI parsing
-    for (int i = 3; i < argc; i += 2) {
-        if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc) {
-            mode = argv[i + 1];
-        } else if (strcmp(argv[i], "--dim") == 0 && i + 1 < argc) {
-            forced_dim = atoi(argv[i + 1]);
-            if (forced_dim != 2 && forced_dim != 3) {
-                fprintf(stderr, "Invalid --dim: must be 2 or 3\n");
-                return 1;
-            }
-        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
-            num_threads = atoi(argv[i + 1]);
-            if (num_threads < 1) {
-                fprintf(stderr, "Invalid --threads: must be at least 1\n");
-                return 1;
-            }
-        } else if (strcmp(argv[i], "--benchmark") == 0) {
-            benchmark = 1;
-            i--;  // Adjust for single-arg flag
-        } else {
-            print_usage(argv[0]);
-            return 1;
-        }
-    }
-
-    if (benchmark) {
-        printf("Running benchmarks (Threads: %d, Dim: %s)...\n", num_threads, forced_dim == 3 ? "3D" : "2D");
-        srand(time(NULL));  // Seed random
-        size_t sizes[] = {100, 1000, 10000};  // Test sizes
-        int is_3d = (forced_dim == 3 ? 1 : 0);
-        for (size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); ++s) {
-            PointSet* set = generate_synthetic_points(sizes[s], is_3d);
-            clock_t start = clock();
-            PointSet* hull = compute_convex_hull(set, num_threads);
-            double time_taken = (double)(clock() - start) / CLOCKS_PER_SEC * 1000.0;
-            size_t hull_count = hull ? hull->count : 0;
-            printf("Size %zu: Time %.2f ms, Simplified to %zu points (Reduction: %.1f%%)\n", 
-                   set->count, time_taken, hull_count, set->count > 0 ? (1.0 - (double)hull_count / set->count) * 100 : 0);
-            free_points(set);
-            free_points(hull);
-        }
-        return 0;
-    }
-
-    clock_t start = clock();
-
-    PointSet* set = load_points(input_file);
-    if (!set) {
-        return 1;
-    }
-
-    // Apply forced dimension if specified
-    if (forced_dim != -1) {
-        set->is_3d = (forced_dim == 3);
-    }
-
-    printf("Loaded %zu points (3D: %d) from %s\n", set->count, set->is_3d, input_file);  // Added file note
-
-    PointSet* result = NULL;
-    if (strcmp(mode, "hull") == 0) {
-        result = compute_convex_hull(set, num_threads);
-        if (!result) {
-            free_points(set);
-            return 1;
-        }
-    } else {
-        fprintf(stderr, "Unknown mode: %s\n", mode);
-        free_points(set);
-        return 1;
-    }
-
-    // Compute metrics
-    float area = compute_area(result);
-    float perimeter = compute_path_length(result);
-
-    // Output results
-    printf("Mode: %s (Threads: %d)\n", mode, num_threads);
-    printf("Simplified from %zu to %zu points\n", set->count, result->count);
-    printf("Area: %.2f\n", area);
-    printf("Perimeter: %.2f\n", perimeter);
-
-    if (save_points(result, output_file) != 0) {
-        free_points(set);
-        free_points(result);
-        return 1;
-    }
-
-    double time_taken = (double)(clock() - start) / CLOCKS_PER_SEC * 1000.0;
-    printf("Computation time: %.2f ms\n", time_taken);
-
-    free_points(set);
-    free_points(result);
-    return 0;
+#include "geometry.h"
+#include "bench.h"
+#include "stats.h"
+#include "quantize.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>  // For the batch queue lock
+
+#define MANIFEST_LINE 8192  // Longest manifest line (input and output path)
+
+/**
+ * @brief Prints usage information.
+ */
+static void print_usage(const char* progname) {
+    fprintf(stderr, "Usage: %s input.csv|input.obj|input.igcb output.csv|output.igcb [--mode hull|hull3d|convert] [--algo graham|monotone|parallel|chan] [--dim 2|3] [--loader mmap|stdio] [--threads N] [--precision N] [--cull] [--grid STEP] [--accum float|double|kahan|pairwise] [--stream [--block N]] [--stats] [--benchmark [bench options]]\n", progname);
+    fprintf(stderr, "       %s --batch manifest.txt [options]\n", progname);
+    fprintf(stderr, "  Supports CSV (x,y[,z]), OBJ (v x y z) or binary .igcb input; .igcb output is binary.\n");
+    fprintf(stderr, "  --mode hull: Compute convex hull (default)\n");
+    fprintf(stderr, "  --mode hull3d: Compute the true 3D convex hull (quickhull); .obj output includes faces\n");
+    fprintf(stderr, "  --mode convert: Rewrite the input in the output's format (e.g. CSV to .igcb)\n");
+    fprintf(stderr, "  --algo graham|monotone|parallel|chan: Hull algorithm (default: graham); parallel hulls each thread's share, then the union; chan is output-sensitive, O(n log h)\n");
+    fprintf(stderr, "  --dim 2|3: Force 2D or 3D mode (default: auto-detect)\n");
+    fprintf(stderr, "  --loader mmap|stdio: Input parser (default: mmap, zero-copy)\n");
+    fprintf(stderr, "  --threads N: Number of threads for computation (default: 1)\n");
+    fprintf(stderr, "  --precision N: Decimal places in the output CSV, 0-9 (default: 2)\n");
+    fprintf(stderr, "  --cull: Discard interior points (Akl-Toussaint octagon) before hull sorting\n");
+    fprintf(stderr, "  --grid STEP: Snap coordinates to multiples of STEP and hull them with exact integer math (monotone chain)\n");
+    fprintf(stderr, "  --accum MODE: Area/perimeter accumulation: float, double, kahan or pairwise (default: float)\n");
+    fprintf(stderr, "  --stream: Hull in bounded memory, reading N points per block (--block, default 1048576)\n");
+    fprintf(stderr, "  --stats: Print per-phase times and counters as JSON to stderr when done\n");
+    fprintf(stderr, "  --benchmark: Run performance benchmarks (ignores input/output files)\n");
+    fprintf(stderr, "    --bench-sizes N,N,...: Point counts (default: 1000,10000,100000)\n");
+    fprintf(stderr, "    --bench-dist LIST|all: uniform, circle, gaussian, clustered, hull (default: all)\n");
+    fprintf(stderr, "    --bench-reps N / --bench-warmup N: Timed and untimed repetitions (default: 10 / 1)\n");
+    fprintf(stderr, "    --bench-format text|json|csv: Report format (default: text, which adds kernel timings)\n");
+    fprintf(stderr, "    --bench-out FILE: Write the report to FILE instead of stdout\n");
+    fprintf(stderr, "  --batch FILE: Hull every 'input output' pair listed in FILE, --threads files at a time\n");
+}
+
+// Runs the hull algorithm selected with --algo, optionally after the culling pre-pass, or the
+// integer grid hull when grid > 0 (which neither culls nor uses the pool: its sort is linear).
+// With an arena, the hull and the culled copy stay in it until the caller resets it.
+static PointSet* run_hull(const PointSet* set, const char* algo, double grid, ThreadPool* pool, Arena* arena,
+                          int cull, size_t* culled) {
+    *culled = 0;
+    if (grid > 0.0) {
+        return compute_convex_hull_grid(set, grid, arena);
+    }
+    PointSet* survivors = NULL;
+    if (cull) {
+        survivors = cull_interior_points(set, arena);
+        if (!survivors) return NULL;
+        *culled = set->count - survivors->count;
+        set = survivors;
+    }
+    PointSet* hull;
+    if (strcmp(algo, "monotone") == 0) {
+        hull = compute_convex_hull_monotone(set, pool, arena);
+    } else if (strcmp(algo, "parallel") == 0) {
+        hull = compute_convex_hull_parallel(set, pool, arena);
+    } else if (strcmp(algo, "chan") == 0) {
+        hull = compute_convex_hull_chan(set, pool, arena);
+    } else {
+        hull = compute_convex_hull(set, pool, arena);
+    }
+    if (!arena) free_points(survivors);
+    return hull;
+}
+
+// Maps an --accum name to its mode; returns -1 for unknown names
+static int parse_accum_mode(const char* name) {
+    static const char* names[] = {"float", "double", "kahan", "pairwise"};
+    for (int k = 0; k < 4; ++k) {
+        if (strcmp(name, names[k]) == 0) return k;
+    }
+    return -1;
+}
+
+// One manifest entry and its outcome
+typedef struct {
+    char* input;
+    char* output;
+    size_t points;
+    size_t hull_count;
+    double area;
+    double perimeter;
+    double ms;
+    int status;  // 0 on success, -1 on failure
+    int done;
+} BatchJob;
+
+// State shared by batch workers: the job queue, ordered reporting and the per-file options
+typedef struct {
+    BatchJob* jobs;
+    size_t count;
+    size_t next;     // Next job to claim
+    size_t printed;  // Summaries are printed in manifest order as jobs finish
+    size_t failed;   // Failed jobs plus malformed manifest lines
+    size_t total_points;
+    pthread_mutex_t lock;
+    const char* algo;
+    double grid;
+    int cull;
+    int forced_dim;
+    int precision;
+    AccumMode accum;
+} BatchState;
+
+// Returns a copy of path, prefixed with the manifest's directory unless it is absolute
+static char* manifest_path(const char* manifest, const char* path) {
+    const char* slash = strrchr(manifest, '/');
+    size_t dir_len = (path[0] == '/' || !slash) ? 0 : (size_t)(slash - manifest) + 1;
+    char* out = malloc(dir_len + strlen(path) + 1);
+    if (out) {
+        memcpy(out, manifest, dir_len);
+        strcpy(out + dir_len, path);
+    }
+    return out;
+}
+
+// Helper: Frees the first count jobs' paths and the job array
+static void free_jobs(BatchJob* jobs, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        free(jobs[i].input);
+        free(jobs[i].output);
+    }
+    free(jobs);
+}
+
+// Reads 'input output' pairs, one per line; blank lines and lines starting with # are skipped,
+// and other lines without exactly two fields are counted in malformed. Relative paths are taken
+// relative to the manifest's directory. Returns NULL if the file cannot be read or memory runs
+// out, so a truncated job list never runs.
+static BatchJob* read_manifest(const char* filename, size_t* count, size_t* malformed) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Error opening manifest '%s'\n", filename);
+        return NULL;
+    }
+    size_t capacity = 16;
+    BatchJob* jobs = malloc(capacity * sizeof(BatchJob));
+    char line[MANIFEST_LINE];
+    size_t line_no = 0;
+    int failed = !jobs;
+    *count = 0;
+    *malformed = 0;
+    while (!failed && fgets(line, sizeof(line), file)) {
+        line_no++;
+        char* fields[3] = {NULL, NULL, NULL};
+        size_t nfields = 0;
+        for (char* tok = strtok(line, " \t\r\n"); tok && nfields < 3; tok = strtok(NULL, " \t\r\n")) {
+            fields[nfields++] = tok;
+        }
+        if (nfields == 0 || fields[0][0] == '#') continue;
+        if (nfields != 2) {
+            fprintf(stderr, "Manifest line %zu: expected 'input output'\n", line_no);
+            (*malformed)++;
+            continue;
+        }
+        if (*count == capacity) {
+            capacity *= 2;
+            BatchJob* grown = realloc(jobs, capacity * sizeof(BatchJob));
+            if (!grown) {
+                failed = 1;
+                break;
+            }
+            jobs = grown;
+        }
+        BatchJob* job = &jobs[*count];
+        memset(job, 0, sizeof(*job));
+        job->input = manifest_path(filename, fields[0]);
+        job->output = manifest_path(filename, fields[1]);
+        if (!job->input || !job->output) {
+            free(job->input);
+            free(job->output);
+            failed = 1;
+            break;
+        }
+        (*count)++;
+    }
+    fclose(file);
+    if (failed) {
+        fprintf(stderr, "Memory allocation failed for manifest\n");
+        if (jobs) free_jobs(jobs, *count);
+        *count = 0;
+        return NULL;
+    }
+    return jobs;
+}
+
+// Loads, hulls, measures and saves one file, reusing the worker's input storage and arena
+static void run_batch_job(const BatchState* state, BatchJob* job, PointSet* input, size_t* capacity, Arena* arena) {
+    double start = stats_now_ms();
+    job->status = -1;
+    if (load_points_into(job->input, input, capacity, NULL) == 0) {  // Files load concurrently instead
+        if (state->forced_dim != -1) input->is_3d = (state->forced_dim == 3);
+        job->points = input->count;
+        size_t culled;
+        PointSet* hull = run_hull(input, state->algo, state->grid, NULL, arena, state->cull, &culled);  // Parallel across files instead
+        if (hull) {
+            job->hull_count = hull->count;
+            double phase_start = stats_phase_begin();
+            job->area = compute_area_accum(hull, state->accum);
+            job->perimeter = compute_path_length_accum(hull, state->accum);
+            stats_phase_end(STATS_PHASE_METRICS, phase_start);
+            job->status = save_points(hull, job->output, state->precision);
+            if (!arena) free_points(hull);
+        }
+        arena_reset(arena);
+    }
+    job->ms = stats_now_ms() - start;
+}
+
+// Worker loop: claims jobs until the queue is empty, printing any summaries that are now in order
+static void batch_worker(void* arg) {
+    BatchState* state = (BatchState*)arg;
+    PointSet input = {NULL, 0, 0};  // Reused for every file this worker loads
+    size_t capacity = 0;
+    Arena* arena = arena_create(0);  // Hull scratch and results, reset after each file (NULL: heap)
+    for (;;) {
+        pthread_mutex_lock(&state->lock);
+        size_t index = state->next < state->count ? state->next++ : state->count;
+        pthread_mutex_unlock(&state->lock);
+        if (index == state->count) break;
+
+        BatchJob* job = &state->jobs[index];
+        run_batch_job(state, job, &input, &capacity, arena);
+
+        pthread_mutex_lock(&state->lock);
+        job->done = 1;
+        while (state->printed < state->count && state->jobs[state->printed].done) {
+            const BatchJob* j = &state->jobs[state->printed++];
+            if (j->status == 0) {
+                printf("%s -> %s: %zu points, hull %zu, area %.2f, perimeter %.2f, %.2f ms\n",
+                       j->input, j->output, j->points, j->hull_count, j->area, j->perimeter, j->ms);
+                state->total_points += j->points;
+            } else {
+                printf("%s -> %s: failed\n", j->input, j->output);
+                state->failed++;
+            }
+        }
+        pthread_mutex_unlock(&state->lock);
+    }
+    free(input.points);
+    arena_destroy(arena);
+}
+
+// Runs every manifest entry with one worker loop per pool thread; returns the process exit code
+static int run_batch(const char* manifest, BatchState* state, ThreadPool* pool) {
+    double start = stats_now_ms();
+    size_t malformed = 0;
+    state->jobs = read_manifest(manifest, &state->count, &malformed);
+    if (!state->jobs) return 1;
+    state->failed = malformed;  // Lines that named no job still fail the batch
+    pthread_mutex_init(&state->lock, NULL);
+
+    size_t workers = thread_pool_size(pool) < state->count ? thread_pool_size(pool) : state->count;
+    thread_pool_run(pool, batch_worker, state, 0, workers);  // arg_size 0: every loop shares state
+
+    double elapsed = stats_now_ms() - start;
+    printf("Batch: %zu files (%zu failed), %zu points in %.2f ms (%.1f files/s, %d workers)\n",
+           state->count + malformed, state->failed, state->total_points, elapsed,
+           elapsed > 0 ? state->count / (elapsed / 1000.0) : 0.0, (int)(workers > 0 ? workers : 1));
+    free_jobs(state->jobs, state->count);
+    pthread_mutex_destroy(&state->lock);
+    return state->failed == 0 ? 0 : 1;
+}
+
+// Prints the --stats report for a run that started at start (no-op unless stats are enabled)
+static void report_stats(double start) {
+    if (stats_enabled()) {
+        stats_write_json(stderr, stats_now_ms() - start);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    const char* input_file = argv[1];
+    const char* output_file = argv[2];
+    char* mode = "hull";  // Default mode
+    char* algo = "graham";  // Default hull algorithm
+    int algo_given = 0;     // Flag: --algo was passed explicitly
+    char* loader = "mmap";  // Default input parser
+    int forced_dim = -1;  // -1: auto, 2: force 2D, 3: force 3D
+    int num_threads = 1;  // Default threads
+    int benchmark = 0;    // Flag for benchmark mode
+    BenchConfig bench;    // --bench-* settings
+    bench_default_config(&bench);
+    const char* bench_out = NULL;  // Report file (default: stdout)
+    int precision = 2;    // Output decimals
+    int cull = 0;         // Flag for interior point culling
+    double grid = 0.0;    // Grid step for the integer hull (0: float hull)
+    int stream = 0;       // Flag for bounded-memory streaming hull
+    size_t block_size = 1 << 20;  // Points per streamed block
+    size_t culled = 0;    // Points removed by culling
+    int batch = argc >= 3 && strcmp(argv[1], "--batch") == 0;  // argv[2] is the manifest
+    AccumMode accum = ACCUM_FLOAT;  // Metric accumulation
+
+    // Simple CLI parsing
+    for (int i = 3; i < argc; i += 2) {
+        if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc) {
+            mode = argv[i + 1];
+        } else if (strcmp(argv[i], "--algo") == 0 && i + 1 < argc) {
+            algo = argv[i + 1];
+            algo_given = 1;
+            if (strcmp(algo, "graham") != 0 && strcmp(algo, "monotone") != 0 && strcmp(algo, "parallel") != 0 &&
+                strcmp(algo, "chan") != 0) {
+                fprintf(stderr, "Invalid --algo: must be graham, monotone, parallel or chan\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--dim") == 0 && i + 1 < argc) {
+            forced_dim = atoi(argv[i + 1]);
+            if (forced_dim != 2 && forced_dim != 3) {
+                fprintf(stderr, "Invalid --dim: must be 2 or 3\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--loader") == 0 && i + 1 < argc) {
+            loader = argv[i + 1];
+            if (strcmp(loader, "mmap") != 0 && strcmp(loader, "stdio") != 0) {
+                fprintf(stderr, "Invalid --loader: must be mmap or stdio\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--accum") == 0 && i + 1 < argc) {
+            int parsed = parse_accum_mode(argv[i + 1]);
+            if (parsed < 0) {
+                fprintf(stderr, "Invalid --accum: must be float, double, kahan or pairwise\n");
+                return 1;
+            }
+            accum = (AccumMode)parsed;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[i + 1]);
+            if (num_threads < 1) {
+                fprintf(stderr, "Invalid --threads: must be at least 1\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--precision") == 0 && i + 1 < argc) {
+            precision = atoi(argv[i + 1]);
+            if (precision < 0 || precision > 9) {
+                fprintf(stderr, "Invalid --precision: must be between 0 and 9\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--cull") == 0) {
+            cull = 1;
+            i--;  // Adjust for single-arg flag
+        } else if (strcmp(argv[i], "--grid") == 0 && i + 1 < argc) {
+            grid = atof(argv[i + 1]);
+            if (!(grid > 0.0)) {
+                fprintf(stderr, "Invalid --grid: must be a positive step, e.g. 0.001\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            stats_enable(1);
+            i--;  // Adjust for single-arg flag
+        } else if (strcmp(argv[i], "--stream") == 0) {
+            stream = 1;
+            i--;  // Adjust for single-arg flag
+        } else if (strcmp(argv[i], "--block") == 0 && i + 1 < argc) {
+            long block = atol(argv[i + 1]);
+            if (block < 3) {
+                fprintf(stderr, "Invalid --block: must be at least 3 points\n");
+                return 1;
+            }
+            block_size = (size_t)block;
+        } else if (strcmp(argv[i], "--benchmark") == 0) {
+            benchmark = 1;
+            i--;  // Adjust for single-arg flag
+        } else if (strcmp(argv[i], "--bench-sizes") == 0 && i + 1 < argc) {
+            if (bench_parse_sizes(argv[i + 1], &bench) != 0) {
+                fprintf(stderr, "Invalid --bench-sizes: expected up to %d comma-separated counts of at least 3\n", BENCH_MAX_SIZES);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--bench-dist") == 0 && i + 1 < argc) {
+            if (bench_parse_distributions(argv[i + 1], &bench.distributions) != 0) {
+                fprintf(stderr, "Invalid --bench-dist: must be all or a list of uniform, circle, gaussian, clustered, hull\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--bench-reps") == 0 && i + 1 < argc) {
+            bench.reps = atoi(argv[i + 1]);
+            if (bench.reps < 1) {
+                fprintf(stderr, "Invalid --bench-reps: must be at least 1\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--bench-warmup") == 0 && i + 1 < argc) {
+            bench.warmup = atoi(argv[i + 1]);
+            if (bench.warmup < 0) {
+                fprintf(stderr, "Invalid --bench-warmup: must be at least 0\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--bench-format") == 0 && i + 1 < argc) {
+            const char* format = argv[i + 1];
+            if (strcmp(format, "text") == 0) {
+                bench.format = BENCH_TEXT;
+            } else if (strcmp(format, "json") == 0) {
+                bench.format = BENCH_JSON;
+            } else if (strcmp(format, "csv") == 0) {
+                bench.format = BENCH_CSV;
+            } else {
+                fprintf(stderr, "Invalid --bench-format: must be text, json or csv\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--bench-out") == 0 && i + 1 < argc) {
+            bench_out = argv[i + 1];
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (grid > 0.0) {
+        if (stream || strcmp(mode, "hull") != 0) {
+            fprintf(stderr, "--grid only supports --mode hull without --stream\n");
+            return 1;
+        }
+        if (cull || (algo_given && strcmp(algo, "monotone") != 0)) {
+            // The grid hull is a monotone chain on radix-sorted cells; its sort is linear, so
+            // culling in float first buys little
+            fprintf(stderr, "--grid always runs the monotone chain and does not support --cull\n");
+            return 1;
+        }
+        algo = "monotone";  // What the grid hull runs
+    }
+
+    if (stream) {
+        if (cull || (algo_given && strcmp(algo, "monotone") != 0)) {
+            fprintf(stderr, "--stream always runs the monotone chain and does not support --cull\n");
+            return 1;
+        }
+        algo = "monotone";  // What the streamed blocks are merged with
+    }
+
+    if (batch && (strcmp(mode, "hull") != 0 || stream || benchmark)) {
+        fprintf(stderr, "--batch only supports --mode hull without --stream or --benchmark\n");
+        return 1;
+    }
+
+    ThreadPool* pool = thread_pool_create(num_threads);  // Shared by every parallel step below
+    if (!pool) {
+        return 1;
+    }
+    double start = stats_now_ms();  // Wall clock: CPU time would add up every thread
+
+    if (batch) {
+        BatchState state;
+        memset(&state, 0, sizeof(state));
+        state.algo = algo;
+        state.grid = grid;
+        state.cull = cull;
+        state.forced_dim = forced_dim;
+        state.precision = precision;
+        state.accum = accum;
+        int status = run_batch(argv[2], &state, pool);
+        report_stats(start);
+        thread_pool_destroy(pool);
+        return status;
+    }
+
+    if (benchmark) {
+        FILE* out = bench_out ? fopen(bench_out, "w") : stdout;
+        if (!out) {
+            fprintf(stderr, "Error opening benchmark report '%s'\n", bench_out);
+            thread_pool_destroy(pool);
+            return 1;
+        }
+        bench.algo = algo;
+        bench.grid = grid;
+        bench.cull = cull;
+        bench.is_3d = (forced_dim == 3);
+        bench.accum = accum;
+        bench.pool = pool;
+        int status = bench_run(&bench, out);
+        if (bench.format == BENCH_TEXT) {
+            bench_kernels(1 << 22, bench.is_3d, 5, out);  // Bandwidth-bound size
+        }
+        if (out != stdout) fclose(out);
+        thread_pool_destroy(pool);
+        return status == 0 ? 0 : 1;
+    }
+
+    PointSet* set = NULL;      // Full input (not materialized in --stream mode)
+    PointSet* result = NULL;
+    size_t input_count = 0;
+    if (stream) {
+        if (strcmp(mode, "hull") != 0) {
+            fprintf(stderr, "--stream only supports --mode hull\n");
+            thread_pool_destroy(pool);
+            return 1;
+        }
+        PointReader* reader = point_reader_open(input_file);
+        if (!reader) {
+            thread_pool_destroy(pool);
+            return 1;
+        }
+        result = compute_convex_hull_stream(reader, block_size, pool, &input_count);
+        point_reader_close(reader);
+        if (!result) {
+            thread_pool_destroy(pool);
+            return 1;
+        }
+        if (forced_dim != -1) {
+            result->is_3d = (forced_dim == 3);
+        }
+        printf("Streamed %zu points (3D: %d) from %s in blocks of %zu\n", input_count, result->is_3d, input_file, block_size);
+    } else {
+        set = strcmp(loader, "mmap") == 0 ? load_points_mmap(input_file, pool) : load_points(input_file);
+        if (!set) {
+            thread_pool_destroy(pool);
+            return 1;
+        }
+        input_count = set->count;
+
+        // Apply forced dimension if specified
+        if (forced_dim != -1) {
+            set->is_3d = (forced_dim == 3);
+        }
+
+        printf("Loaded %zu points (3D: %d) from %s\n", set->count, set->is_3d, input_file);  // Added file note
+
+        if (strcmp(mode, "convert") == 0) {
+            // Format migration: no geometry, just re-encode the points
+            int status = save_points(set, output_file, precision);
+            if (status == 0) {
+                printf("Mode: convert\n");
+                printf("Wrote %zu points to %s\n", set->count, output_file);
+                printf("Computation time: %.2f ms\n", stats_now_ms() - start);
+                report_stats(start);
+            }
+            free_points(set);
+            thread_pool_destroy(pool);
+            return status == 0 ? 0 : 1;
+        }
+
+        if (strcmp(mode, "hull3d") == 0) {
+            HullMesh* mesh = compute_convex_hull_3d(set, pool);
+            if (!mesh) {
+                free_points(set);
+                thread_pool_destroy(pool);
+                return 1;
+            }
+            printf("Mode: %s (Threads: %d)\n", mode, num_threads);
+            printf("Hull: %zu vertices, %zu triangles (from %zu points)\n", mesh->vertex_count, mesh->face_count, set->count);
+            double phase_start = stats_phase_begin();
+            float surface_area = compute_surface_area(mesh);
+            float volume = compute_volume(mesh);
+            stats_phase_end(STATS_PHASE_METRICS, phase_start);
+            printf("Surface area: %.2f\n", surface_area);
+            printf("Volume: %.2f\n", volume);
+            int status = save_mesh(mesh, output_file, precision);
+            if (status == 0) {
+                printf("Computation time: %.2f ms\n", stats_now_ms() - start);
+                report_stats(start);
+            }
+            free_mesh(mesh);
+            free_points(set);
+            thread_pool_destroy(pool);
+            return status == 0 ? 0 : 1;
+        }
+
+        if (strcmp(mode, "hull") == 0) {
+            result = run_hull(set, algo, grid, pool, NULL, cull, &culled);
+            if (!result) {
+                free_points(set);
+                thread_pool_destroy(pool);
+                return 1;
+            }
+        } else {
+            fprintf(stderr, "Unknown mode: %s\n", mode);
+            free_points(set);
+            thread_pool_destroy(pool);
+            return 1;
+        }
+    }
+
+    // Compute metrics
+    double phase_start = stats_phase_begin();
+    double area = compute_area_accum(result, accum);
+    double perimeter = compute_path_length_accum(result, accum);
+    stats_phase_end(STATS_PHASE_METRICS, phase_start);
+
+    // Output results
+    printf("Mode: %s (Algo: %s, Threads: %d)\n", mode, algo, num_threads);
+    if (grid > 0.0) {
+        printf("Grid step %g: exact integer hull\n", grid);
+    }
+    if (cull) {
+        printf("Culled %zu of %zu points before sorting (%.1f%%)\n", culled, input_count,
+               input_count > 0 ? (double)culled / input_count * 100 : 0);
+    }
+    printf("Simplified from %zu to %zu points\n", input_count, result->count);
+    printf("Area: %.2f\n", area);
+    printf("Perimeter: %.2f\n", perimeter);
+
+    if (save_points(result, output_file, precision) != 0) {
+        free_points(set);
+        free_points(result);
+        thread_pool_destroy(pool);
+        return 1;
+    }
+
+    printf("Computation time: %.2f ms\n", stats_now_ms() - start);
+    report_stats(start);
+
+    free_points(set);
+    free_points(result);
+    thread_pool_destroy(pool);
+    return 0;
 }
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include "predicates.h"
+#include <float.h>  // For DBL_EPSILON
+#include <math.h>   // For fabs
+
+// Adaptive-precision orientation after J. R. Shewchuk, "Adaptive Precision Floating-Point
+// Arithmetic and Fast Robust Geometric Predicates" (1997). The float inputs are widened to
+// double; the determinant is first evaluated in plain double arithmetic and only refined with
+// exact expansion arithmetic when it lies inside the rounding error bound. The bounds assume
+// IEEE double evaluation without FMA contraction (the default for -std=c99 builds).
+
+#define HALF_EPSILON (DBL_EPSILON / 2.0)  // 2^-53, Shewchuk's epsilon
+#define SPLITTER 134217729.0              // 2^27 + 1, splits a double into two 26-bit halves
+
+static const double resulterrbound = (3.0 + 8.0 * HALF_EPSILON) * HALF_EPSILON;
+static const double ccwerrboundA = (3.0 + 16.0 * HALF_EPSILON) * HALF_EPSILON;
+static const double ccwerrboundB = (2.0 + 12.0 * HALF_EPSILON) * HALF_EPSILON;
+static const double ccwerrboundC = (9.0 + 64.0 * HALF_EPSILON) * HALF_EPSILON * HALF_EPSILON;
+
+static unsigned long exact_calls = 0;  // Updated with relaxed atomics (sorts call this from threads)
+
+// Helper: x + y = a + b exactly, given |a| >= |b|
+static inline void fast_two_sum(double a, double b, double* x, double* y) {
+    *x = a + b;
+    double bvirt = *x - a;
+    *y = b - bvirt;
+}
+
+// Helper: x + y = a + b exactly
+static inline void two_sum(double a, double b, double* x, double* y) {
+    *x = a + b;
+    double bvirt = *x - a;
+    double avirt = *x - bvirt;
+    *y = (a - avirt) + (b - bvirt);
+}
+
+// Helper: Rounding error of x = a - b
+static inline double two_diff_tail(double a, double b, double x) {
+    double bvirt = a - x;
+    double avirt = x + bvirt;
+    return (a - avirt) + (bvirt - b);
+}
+
+// Helper: x + y = a - b exactly
+static inline void two_diff(double a, double b, double* x, double* y) {
+    *x = a - b;
+    *y = two_diff_tail(a, b, *x);
+}
+
+// Helper: Splits a into high and low halves with non-overlapping 26-bit significands
+static inline void split(double a, double* hi, double* lo) {
+    double c = SPLITTER * a;
+    double abig = c - a;
+    *hi = c - abig;
+    *lo = a - *hi;
+}
+
+// Helper: x + y = a * b exactly (Dekker's product)
+static inline void two_product(double a, double b, double* x, double* y) {
+    *x = a * b;
+    double ahi, alo, bhi, blo;
+    split(a, &ahi, &alo);
+    split(b, &bhi, &blo);
+    double err1 = *x - ahi * bhi;
+    double err2 = err1 - alo * bhi;
+    double err3 = err2 - ahi * blo;
+    *y = alo * blo - err3;
+}
+
+// Helper: Expansion x[0..3] (increasing magnitude) = (a1 + a0) - (b1 + b0) exactly
+static void two_two_diff(double a1, double a0, double b1, double b0, double* x) {
+    double i, j, zero;
+    two_diff(a0, b0, &i, &x[0]);
+    two_sum(a1, i, &j, &zero);
+    two_diff(zero, b1, &i, &x[1]);
+    two_sum(j, i, &x[3], &x[2]);
+}
+
+// Helper: h = e + f for nonoverlapping expansions, dropping zero components. Returns h's length.
+static int fast_expansion_sum_zeroelim(int elen, const double* e, int flen, const double* f, double* h) {
+    double q, qnew, hh;
+    double enow = e[0], fnow = f[0];
+    int eindex = 0, findex = 0, hindex = 0;
+    if ((fnow > enow) == (fnow > -enow)) {
+        q = enow;
+        if (++eindex < elen) enow = e[eindex];
+    } else {
+        q = fnow;
+        if (++findex < flen) fnow = f[findex];
+    }
+    if (eindex < elen && findex < flen) {
+        if ((fnow > enow) == (fnow > -enow)) {
+            fast_two_sum(enow, q, &qnew, &hh);
+            if (++eindex < elen) enow = e[eindex];
+        } else {
+            fast_two_sum(fnow, q, &qnew, &hh);
+            if (++findex < flen) fnow = f[findex];
+        }
+        q = qnew;
+        if (hh != 0.0) h[hindex++] = hh;
+        while (eindex < elen && findex < flen) {
+            if ((fnow > enow) == (fnow > -enow)) {
+                two_sum(q, enow, &qnew, &hh);
+                if (++eindex < elen) enow = e[eindex];
+            } else {
+                two_sum(q, fnow, &qnew, &hh);
+                if (++findex < flen) fnow = f[findex];
+            }
+            q = qnew;
+            if (hh != 0.0) h[hindex++] = hh;
+        }
+    }
+    while (eindex < elen) {
+        two_sum(q, enow, &qnew, &hh);
+        if (++eindex < elen) enow = e[eindex];
+        q = qnew;
+        if (hh != 0.0) h[hindex++] = hh;
+    }
+    while (findex < flen) {
+        two_sum(q, fnow, &qnew, &hh);
+        if (++findex < flen) fnow = f[findex];
+        q = qnew;
+        if (hh != 0.0) h[hindex++] = hh;
+    }
+    if (q != 0.0 || hindex == 0) h[hindex++] = q;
+    return hindex;
+}
+
+// Helper: Adaptive stages B, C and D for determinants the filter could not decide
+static double orient2d_adapt(double ax, double ay, double bx, double by, double cx, double cy, double detsum) {
+    double acx = ax - cx, bcx = bx - cx;
+    double acy = ay - cy, bcy = by - cy;
+
+    double detleft, detlefttail, detright, detrighttail;
+    two_product(acx, bcy, &detleft, &detlefttail);
+    two_product(acy, bcx, &detright, &detrighttail);
+    double b[4];
+    two_two_diff(detleft, detlefttail, detright, detrighttail, b);
+
+    double det = b[0] + b[1] + b[2] + b[3];
+    double errbound = ccwerrboundB * detsum;
+    if (det >= errbound || -det >= errbound) return det;
+
+    double acxtail = two_diff_tail(ax, cx, acx);
+    double bcxtail = two_diff_tail(bx, cx, bcx);
+    double acytail = two_diff_tail(ay, cy, acy);
+    double bcytail = two_diff_tail(by, cy, bcy);
+    if (acxtail == 0.0 && acytail == 0.0 && bcxtail == 0.0 && bcytail == 0.0) return det;
+
+    errbound = ccwerrboundC * detsum + resulterrbound * (det >= 0.0 ? det : -det);
+    det += (acx * bcytail + bcy * acxtail) - (acy * bcxtail + bcx * acytail);
+    if (det >= errbound || -det >= errbound) return det;
+
+    double s1, s0, t1, t0, u[4], c1[8], c2[12], d[16];
+    two_product(acxtail, bcy, &s1, &s0);
+    two_product(acytail, bcx, &t1, &t0);
+    two_two_diff(s1, s0, t1, t0, u);
+    int c1len = fast_expansion_sum_zeroelim(4, b, 4, u, c1);
+
+    two_product(acx, bcytail, &s1, &s0);
+    two_product(acy, bcxtail, &t1, &t0);
+    two_two_diff(s1, s0, t1, t0, u);
+    int c2len = fast_expansion_sum_zeroelim(c1len, c1, 4, u, c2);
+
+    two_product(acxtail, bcytail, &s1, &s0);
+    two_product(acytail, bcxtail, &t1, &t0);
+    two_two_diff(s1, s0, t1, t0, u);
+    int dlen = fast_expansion_sum_zeroelim(c2len, c2, 4, u, d);
+    return d[dlen - 1];
+}
+
+/**
+ * @brief Robust 2D orientation test on bare coordinates.
+ *
+ * Returns twice the signed area of triangle abc, or an approximation of it whose sign is
+ * always correct: positive if a, b, c turn counterclockwise, negative if clockwise and zero
+ * only if they are exactly collinear. The double-precision filter decides almost every call;
+ * exact arithmetic runs only near degeneracy. Taking coordinates rather than a Point lets
+ * callers test points stored in any layout.
+ * @param ax, ay, bx, by, cx, cy Coordinates of the three points.
+ * @return Orientation determinant with exact sign.
+ */
+double orient2d_xy(float ax, float ay, float bx, float by, float cx, float cy) {
+    double detleft = ((double)ax - cx) * ((double)by - cy);
+    double detright = ((double)ay - cy) * ((double)bx - cx);
+    double det = detleft - detright;
+
+    // Branch-free form of Shewchuk's filter: when the products differ in sign |det| equals
+    // detsum up to rounding and always passes, so only one well-predicted test remains
+    double detsum = fabs(detleft) + fabs(detright);
+    if (fabs(det) >= ccwerrboundA * detsum) return det;
+
+    __atomic_fetch_add(&exact_calls, 1, __ATOMIC_RELAXED);
+    return orient2d_adapt(ax, ay, bx, by, cx, cy, detsum);
+}
+
+/**
+ * @brief Robust 2D orientation test (z ignored).
+ * @param a, b, c Points to test.
+ * @return Orientation determinant with exact sign (see orient2d_xy).
+ */
+double orient2d(const Point* a, const Point* b, const Point* c) {
+    return orient2d_xy(a->x, a->y, b->x, b->y, c->x, c->y);
+}
+
+/**
+ * @brief Non-robust orientation estimate in double precision (same sign convention).
+ * @param a, b, c Points to test.
+ * @return Orientation determinant, possibly with the wrong sign near degeneracy.
+ */
+double orient2d_fast(const Point* a, const Point* b, const Point* c) {
+    return ((double)a->x - c->x) * ((double)b->y - c->y) - ((double)a->y - c->y) * ((double)b->x - c->x);
+}
+
+/**
+ * @brief Returns how many orient2d calls needed the adaptive stages since startup.
+ * @return Call count.
+ */
+unsigned long orient2d_exact_calls(void) {
+    return __atomic_load_n(&exact_calls, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,448 @@
+#include "quantize.h"
+#include "stats.h"
+#include <stdio.h>   // For fprintf, stderr
+#include <stdlib.h>  // For free
+#include <string.h>  // For memcpy, memset
+#include <math.h>    // For llround, isfinite, fabs
+
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_PASSES (64 / RADIX_BITS)  // Byte passes per key word
+
+// Helper: Cell offsets of one-word points
+static inline uint64_t narrow_x(uint64_t word) { return word >> 32; }
+static inline uint64_t narrow_y(uint64_t word) { return word & 0xffffffffu; }
+
+// Helper: Exact orientation of one-word points: offsets are below 2^31, so each product is
+// below 2^62 and their difference fits in int64
+static inline int orient_narrow(const uint64_t* a, const uint64_t* b, const uint64_t* c) {
+    int64_t cx = (int64_t)narrow_x(*c), cy = (int64_t)narrow_y(*c);
+    int64_t det = ((int64_t)narrow_x(*a) - cx) * ((int64_t)narrow_y(*b) - cy) -
+                  ((int64_t)narrow_y(*a) - cy) * ((int64_t)narrow_x(*b) - cx);
+    return (det > 0) - (det < 0);
+}
+
+// Helper: Exact orientation of two-word points: offsets are below 2^62, so each product is
+// below 2^124 and their difference fits in 128 bits
+static inline int orient_wide(const uint64_t* a, const uint64_t* b, const uint64_t* c) {
+    __int128 det = (__int128)((int64_t)a[0] - (int64_t)c[0]) * ((int64_t)b[1] - (int64_t)c[1]) -
+                   (__int128)((int64_t)a[1] - (int64_t)c[1]) * ((int64_t)b[0] - (int64_t)c[0]);
+    return (det > 0) - (det < 0);
+}
+
+/**
+ * @brief Snaps a point set to a square grid.
+ *
+ * Rounds every coordinate to the nearest multiple of step (half away from zero) and stores
+ * the cells relative to the lowest one, in one word per point when both extents fit in 31
+ * bits and in two words otherwise (see QuantizedSet). Counted as input copy in the sort phase.
+ * @param set Input PointSet.
+ * @param step Grid spacing in input units, e.g. 0.001 for millimetres on metre coordinates.
+ * @param arena Arena for the result (NULL: heap, free with free_quantized).
+ * @return New QuantizedSet, or NULL if step is not positive, a coordinate is not finite or
+ *         the extent exceeds 2^62 cells.
+ */
+QuantizedSet* quantize_points(const PointSet* set, double step, Arena* arena) {
+    if (!set || !(step > 0.0) || !isfinite(step)) {
+        fprintf(stderr, "Invalid grid step: must be a positive number\n");
+        return NULL;
+    }
+    double phase_start = stats_phase_begin();
+
+    // Extreme cells: rounding is monotone, so they are the rounded extremes
+    double min_x = 0.0, max_x = 0.0, min_y = 0.0, max_y = 0.0;
+    int finite = 1;
+    for (size_t i = 0; i < set->count; ++i) {
+        double cx = set->points[i].x / step, cy = set->points[i].y / step;
+        finite &= isfinite(cx) && isfinite(cy);
+        if (i == 0 || cx < min_x) min_x = cx;
+        if (i == 0 || cx > max_x) max_x = cx;
+        if (i == 0 || cy < min_y) min_y = cy;
+        if (i == 0 || cy > max_y) max_y = cy;
+    }
+    const double limit = (double)QUANT_WIDE_CELLS;
+    if (!finite || fabs(min_x) >= limit || fabs(max_x) >= limit || fabs(min_y) >= limit || fabs(max_y) >= limit) {
+        fprintf(stderr, "Grid step %g is too fine for the input coordinates\n", step);
+        return NULL;
+    }
+    int64_t origin_x = llround(min_x), origin_y = llround(min_y);
+    int64_t extent_x = llround(max_x) - origin_x, extent_y = llround(max_y) - origin_y;
+    if (extent_x >= QUANT_WIDE_CELLS || extent_y >= QUANT_WIDE_CELLS) {
+        fprintf(stderr, "Grid step %g is too fine for the input extent\n", step);
+        return NULL;
+    }
+    int narrow = extent_x < QUANT_NARROW_CELLS && extent_y < QUANT_NARROW_CELLS;
+
+    QuantizedSet* q = arena_alloc(arena, sizeof(QuantizedSet));
+    if (!q) {
+        fprintf(stderr, "Memory allocation failed for grid points\n");
+        return NULL;
+    }
+    q->key_words = narrow ? 1 : 2;
+    q->stride = q->key_words + (set->is_3d ? 1 : 0);
+    q->words = arena_alloc(arena, (set->count > 0 ? set->count : 1) * q->stride * sizeof(uint64_t));
+    if (!q->words) {
+        arena_free(arena, q);
+        fprintf(stderr, "Memory allocation failed for grid points\n");
+        return NULL;
+    }
+    q->count = set->count;
+    q->origin_x = origin_x;
+    q->origin_y = origin_y;
+    q->step = step;
+    q->is_3d = set->is_3d;
+
+    for (size_t i = 0; i < set->count; ++i) {
+        const Point* p = &set->points[i];
+        uint64_t x = (uint64_t)(llround(p->x / step) - origin_x);
+        uint64_t y = (uint64_t)(llround(p->y / step) - origin_y);
+        uint64_t* w = q->words + i * q->stride;
+        if (narrow) {
+            w[0] = x << 32 | y;
+        } else {
+            w[0] = x;
+            w[1] = y;
+        }
+        if (set->is_3d) {
+            uint32_t bits;
+            memcpy(&bits, &p->z, sizeof(bits));
+            w[q->key_words] = bits;
+        }
+    }
+    stats_phase_end(STATS_PHASE_SORT, phase_start);
+    return q;
+}
+
+/**
+ * @brief Converts grid points back to float coordinates.
+ *
+ * Each point becomes (origin + offset) * step, computed in double and rounded once to float;
+ * 3D points get their carried z back. Counted in the scan phase, as hull output.
+ * @param q Quantized set.
+ * @param arena Arena for the result (NULL: heap, free with free_points).
+ * @return New PointSet, or NULL on failure.
+ */
+PointSet* dequantize_points(const QuantizedSet* q, Arena* arena) {
+    if (!q) return NULL;
+    double phase_start = stats_phase_begin();
+    PointSet* set = arena_alloc(arena, sizeof(PointSet));
+    if (!set) {
+        fprintf(stderr, "Memory allocation failed for grid points\n");
+        return NULL;
+    }
+    set->points = arena_alloc(arena, (q->count > 0 ? q->count : 1) * sizeof(Point));
+    if (!set->points) {
+        arena_free(arena, set);
+        fprintf(stderr, "Memory allocation failed for grid points\n");
+        return NULL;
+    }
+    set->count = q->count;
+    set->is_3d = q->is_3d;
+
+    for (size_t i = 0; i < q->count; ++i) {
+        const uint64_t* w = q->words + i * q->stride;
+        uint64_t x = q->key_words == 1 ? narrow_x(w[0]) : w[0];
+        uint64_t y = q->key_words == 1 ? narrow_y(w[0]) : w[1];
+        Point* p = &set->points[i];
+        p->x = (float)((double)(q->origin_x + (int64_t)x) * q->step);
+        p->y = (float)((double)(q->origin_y + (int64_t)y) * q->step);
+        p->z = 0.0f;
+        if (q->is_3d) {
+            uint32_t bits = (uint32_t)w[q->key_words];
+            memcpy(&p->z, &bits, sizeof(bits));
+        }
+    }
+    stats_phase_end(STATS_PHASE_SCAN, phase_start);
+    return set;
+}
+
+/**
+ * @brief Frees a heap-allocated QuantizedSet.
+ * @param q Set to free (NULL is ignored).
+ */
+void free_quantized(QuantizedSet* q) {
+    if (q) {
+        free(q->words);
+        free(q);
+    }
+}
+
+// Helper: One stable counting pass on byte shift of word `word`, scattering src into dst.
+// Inlined per stride (see radix_sort_words) so the element copy is unrolled.
+static inline void radix_pass(const uint64_t* src, uint64_t* dst, size_t n, size_t stride, size_t word,
+                              unsigned shift, size_t* offsets) {
+    for (size_t i = 0; i < n; ++i) {
+        const uint64_t* e = src + i * stride;
+        uint64_t* out = dst + offsets[(e[word] >> shift) & (RADIX_BUCKETS - 1)]++ * stride;
+        for (size_t w = 0; w < stride; ++w) out[w] = e[w];
+    }
+}
+
+// Helper: radix_pass specialized for the common strides
+static void radix_scatter_range(const uint64_t* src, uint64_t* dst, size_t n, size_t stride, size_t word,
+                                unsigned shift, size_t* offsets) {
+    switch (stride) {
+        case 1: radix_pass(src, dst, n, 1, word, shift, offsets); break;
+        case 2: radix_pass(src, dst, n, 2, word, shift, offsets); break;
+        case 3: radix_pass(src, dst, n, 3, word, shift, offsets); break;
+        default: radix_pass(src, dst, n, stride, word, shift, offsets); break;
+    }
+}
+
+// Task arg for one chunk of a parallel radix sort
+typedef struct {
+    const uint64_t* src;
+    uint64_t* dst;
+    size_t start;   // Elements [start, end) of src
+    size_t end;
+    size_t stride;
+    size_t word;    // Key word being sorted on
+    unsigned shift;
+    size_t counts[RADIX_PASSES][RADIX_BUCKETS];  // Byte histograms of the chunk
+    size_t offsets[RADIX_BUCKETS];               // Chunk's next output slot per byte value
+} RadixArg;
+
+// Task function: histograms every byte of the current key word over one chunk
+static void radix_count(void* arg) {
+    RadixArg* r = (RadixArg*)arg;
+    memset(r->counts, 0, sizeof(r->counts));
+    for (size_t i = r->start; i < r->end; ++i) {
+        uint64_t key = r->src[i * r->stride + r->word];
+        for (int b = 0; b < RADIX_PASSES; ++b) {
+            r->counts[b][(key >> (b * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+        }
+    }
+}
+
+// Task function: scatters one chunk by the current byte
+static void radix_scatter(void* arg) {
+    RadixArg* r = (RadixArg*)arg;
+    radix_scatter_range(r->src + r->start * r->stride, r->dst, r->end - r->start, r->stride, r->word, r->shift,
+                        r->offsets);
+}
+
+// Helper: radix_sort_words over tasks chunks on the pool. Each byte pass histograms the chunks
+// in their current order, gives every chunk its own output slots per byte value (chunk order
+// within a value keeps the sort stable) and scatters the chunks in parallel. Returns the
+// buffer holding the result.
+static uint64_t* radix_sort_chunks(uint64_t* src, uint64_t* dst, size_t n, size_t stride, size_t key_words,
+                                   ThreadPool* pool, RadixArg* args, size_t tasks) {
+    for (size_t t = 0; t < tasks; ++t) {
+        args[t].start = n * t / tasks;
+        args[t].end = n * (t + 1) / tasks;
+        args[t].stride = stride;
+    }
+    for (size_t word = key_words; word-- > 0; ) {
+        int b = 0;
+        while (b < RADIX_PASSES) {
+            for (size_t t = 0; t < tasks; ++t) {
+                args[t].src = src;
+                args[t].word = word;
+            }
+            thread_pool_run(pool, radix_count, args, sizeof(RadixArg), tasks);
+            // Next byte on which the elements differ
+            for (; b < RADIX_PASSES; ++b) {
+                int trivial = 0;
+                for (int v = 0; v < RADIX_BUCKETS && !trivial; ++v) {
+                    size_t total = 0;
+                    for (size_t t = 0; t < tasks; ++t) total += args[t].counts[b][v];
+                    trivial = total == n;
+                }
+                if (!trivial) break;
+            }
+            if (b == RADIX_PASSES) break;
+            size_t total = 0;
+            for (int v = 0; v < RADIX_BUCKETS; ++v) {
+                for (size_t t = 0; t < tasks; ++t) {
+                    args[t].offsets[v] = total;
+                    total += args[t].counts[b][v];
+                }
+            }
+            for (size_t t = 0; t < tasks; ++t) {
+                args[t].dst = dst;
+                args[t].shift = (unsigned)(b * RADIX_BITS);
+            }
+            thread_pool_run(pool, radix_scatter, args, sizeof(RadixArg), tasks);
+            uint64_t* tmp = src;
+            src = dst;
+            dst = tmp;
+            b++;
+        }
+    }
+    return src;
+}
+
+/**
+ * @brief Stable LSD radix sort of fixed-size elements by their leading key words.
+ *
+ * Elements are stride words; the first key_words words form the key, most significant
+ * first, and the rest ride along. One read per key word fills all eight byte histograms,
+ * and a byte on which every element agrees costs no pass, so small offsets (a 32-bit grid in
+ * a 64-bit word, say) sort in as few passes as their width needs. With a pool, every pass is
+ * split into per-thread chunks.
+ * @param elems Elements to sort (n * stride words).
+ * @param scratch Buffer of the same size.
+ * @param n Number of elements.
+ * @param stride Words per element.
+ * @param key_words Key words per element (at most stride).
+ * @param pool Thread pool for the passes (NULL sorts on the calling thread).
+ * @param arena Arena for the per-thread histograms of a pooled sort (NULL: heap).
+ */
+void radix_sort_words(uint64_t* elems, uint64_t* scratch, size_t n, size_t stride, size_t key_words,
+                      ThreadPool* pool, Arena* arena) {
+    if (n < 2) return;
+    uint64_t* src = elems;
+    uint64_t* dst = scratch;
+    size_t tasks = thread_pool_parallelism(pool, n);
+    RadixArg* args = tasks > 1 ? arena_alloc(arena, tasks * sizeof(RadixArg)) : NULL;  // Serial on OOM
+    if (args) {
+        src = radix_sort_chunks(src, dst, n, stride, key_words, pool, args, tasks);
+        arena_free(arena, args);
+    } else {
+        for (size_t word = key_words; word-- > 0; ) {
+            size_t counts[RADIX_PASSES][RADIX_BUCKETS];
+            memset(counts, 0, sizeof(counts));
+            for (size_t i = 0; i < n; ++i) {
+                uint64_t key = src[i * stride + word];
+                for (int b = 0; b < RADIX_PASSES; ++b) {
+                    counts[b][(key >> (b * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+                }
+            }
+            for (int b = 0; b < RADIX_PASSES; ++b) {
+                size_t offsets[RADIX_BUCKETS];
+                size_t total = 0;
+                int trivial = 0;
+                for (int v = 0; v < RADIX_BUCKETS; ++v) {
+                    trivial |= counts[b][v] == n;  // Every element has this byte
+                    offsets[v] = total;
+                    total += counts[b][v];
+                }
+                if (trivial) continue;
+                radix_scatter_range(src, dst, n, stride, word, (unsigned)(b * RADIX_BITS), offsets);
+                uint64_t* tmp = src;
+                src = dst;
+                dst = tmp;
+            }
+        }
+    }
+    if (src != elems) {
+        memcpy(elems, src, n * stride * sizeof(uint64_t));
+    }
+}
+
+// Helper: Monotone chain over n sorted grid points into out (room for n + 1); returns the chain
+// length, whose last point repeats the first. Inlined per layout (see chain_scan) so the
+// stride and the orientation width are constants.
+static inline size_t monotone_chain(const uint64_t* points, size_t n, uint64_t* out, size_t stride, int wide,
+                                    size_t* pops) {
+    size_t k = 0;
+    // Lower chain, left to right
+    for (size_t i = 0; i < n; ++i) {
+        const uint64_t* p = points + i * stride;
+        while (k >= 2 && (wide ? orient_wide(out + (k-2) * stride, out + (k-1) * stride, p)
+                               : orient_narrow(out + (k-2) * stride, out + (k-1) * stride, p)) <= 0) {
+            k--;
+            (*pops)++;
+        }
+        memcpy(out + k++ * stride, p, stride * sizeof(uint64_t));
+    }
+    // Upper chain, right to left
+    size_t lower_size = k + 1;
+    for (size_t i = n - 1; i-- > 0; ) {
+        const uint64_t* p = points + i * stride;
+        while (k >= lower_size && (wide ? orient_wide(out + (k-2) * stride, out + (k-1) * stride, p)
+                                        : orient_narrow(out + (k-2) * stride, out + (k-1) * stride, p)) <= 0) {
+            k--;
+            (*pops)++;
+        }
+        memcpy(out + k++ * stride, p, stride * sizeof(uint64_t));
+    }
+    return k;
+}
+
+// Helper: monotone_chain specialized for each layout
+static size_t chain_scan(const QuantizedSet* q, uint64_t* out, size_t* pops) {
+    if (q->key_words == 1) {
+        return q->is_3d ? monotone_chain(q->words, q->count, out, 2, 0, pops)
+                        : monotone_chain(q->words, q->count, out, 1, 0, pops);
+    }
+    return q->is_3d ? monotone_chain(q->words, q->count, out, 3, 1, pops)
+                    : monotone_chain(q->words, q->count, out, 2, 1, pops);
+}
+
+/**
+ * @brief Computes the convex hull of grid points with exact integer arithmetic.
+ *
+ * Andrew's monotone chain on the (x, y) order: the sort is radix_sort_words on the packed
+ * cells, with no comparator, and every turn is decided exactly, so the result does not
+ * depend on thread count or rounding. Collinear and duplicate points are dropped; since the
+ * sort is stable, which of several duplicates keeps its z is fixed by the input order.
+ * @param q Grid points; sorted in place.
+ * @param arena Arena for the scratch and result (NULL: heap, free with free_quantized).
+ * @return New QuantizedSet with the hull vertices in counterclockwise order, or NULL on failure.
+ */
+QuantizedSet* compute_convex_hull_quantized(QuantizedSet* q, Arena* arena) {
+    if (!q || q->count < 3) {
+        fprintf(stderr, "Convex hull requires at least 3 points\n");
+        return NULL;
+    }
+    size_t n = q->count, stride = q->stride;
+
+    double phase_start = stats_phase_begin();
+    uint64_t* scratch = arena_alloc(arena, n * stride * sizeof(uint64_t));
+    if (!scratch) {
+        fprintf(stderr, "Memory allocation failed for hull\n");
+        return NULL;
+    }
+    radix_sort_words(q->words, scratch, n, stride, q->key_words, NULL, arena);
+    arena_free(arena, scratch);
+    stats_phase_end(STATS_PHASE_SORT, phase_start);
+    phase_start = stats_phase_begin();
+
+    QuantizedSet* hull = arena_alloc(arena, sizeof(QuantizedSet));
+    if (!hull) {
+        fprintf(stderr, "Memory allocation failed for hull\n");
+        return NULL;
+    }
+    *hull = *q;
+    hull->words = arena_alloc(arena, (n + 1) * stride * sizeof(uint64_t));  // Chain closes on the first point
+    if (!hull->words) {
+        arena_free(arena, hull);
+        fprintf(stderr, "Memory allocation failed for hull\n");
+        return NULL;
+    }
+    size_t pops = 0;
+    hull->count = chain_scan(q, hull->words, &pops) - 1;  // Last point repeats the first
+    stats_add(STATS_HULL_POPS, pops);
+
+    if (hull->count > 0) {
+        uint64_t* shrunk = arena_resize(arena, hull->words, (n + 1) * stride * sizeof(uint64_t),
+                                        hull->count * stride * sizeof(uint64_t));
+        if (shrunk) hull->words = shrunk;
+    }
+    stats_phase_end(STATS_PHASE_SCAN, phase_start);
+    return hull;
+}
+
+/**
+ * @brief Computes the convex hull on a grid: quantize, exact integer hull, dequantize.
+ * @param set Input PointSet.
+ * @param step Grid spacing in input units.
+ * @param arena Arena for the intermediates and result (NULL: heap, free with free_points).
+ * @return New PointSet with the hull vertices (on grid points) in counterclockwise order, or NULL on failure.
+ */
+PointSet* compute_convex_hull_grid(const PointSet* set, double step, Arena* arena) {
+    if (!set || set->count < 3) {
+        fprintf(stderr, "Convex hull requires at least 3 points\n");
+        return NULL;
+    }
+    QuantizedSet* q = quantize_points(set, step, arena);
+    if (!q) return NULL;
+    QuantizedSet* qhull = compute_convex_hull_quantized(q, arena);
+    PointSet* hull = qhull ? dequantize_points(qhull, arena) : NULL;
+    if (!arena) {
+        free_quantized(qhull);
+        free_quantized(q);
+    }
+    return hull;
+}
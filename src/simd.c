@@ -0,0 +1,684 @@
+#include "simd.h"
+#include <math.h>     // For sqrtf, sqrt
+#include <pthread.h>  // For pthread_once
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SIMD_X86 1
+#include <immintrin.h>  // SSE2/AVX2 intrinsics, enabled per function with target attributes
+#else
+#define SIMD_X86 0
+#endif
+
+// Shuffle control listing source lanes in result order (the reverse of _MM_SHUFFLE)
+#define LANES(l0, l1, l2, l3) _MM_SHUFFLE(l3, l2, l1, l0)
+
+// Kernel table for one instruction set
+typedef struct {
+    float (*shoelace_aos)(const Point* points, size_t n);
+    float (*shoelace_soa)(const float* x, const float* y, size_t n);
+    float (*length_aos)(const Point* points, size_t n);
+    float (*length_soa)(const float* x, const float* y, const float* z, size_t n);
+} SimdKernels;
+
+// Helper: Sums vector lanes in a fixed order so AoS and SoA kernels round identically
+static float sum_lanes(const float* lanes, size_t count) {
+    float sum = 0.0f;
+    for (size_t k = 0; k < count; ++k) sum += lanes[k];
+    return sum;
+}
+
+// Helper: Adds the shoelace terms of edges i..n-2 and the closing edge to area
+static float shoelace_tail_aos(const Point* p, size_t n, size_t i, float area) {
+    for (; i + 1 < n; ++i) {
+        area += p[i].x * p[i + 1].y;
+        area -= p[i + 1].x * p[i].y;
+    }
+    area += p[n - 1].x * p[0].y;
+    area -= p[0].x * p[n - 1].y;
+    return area;
+}
+
+static float shoelace_tail_soa(const float* x, const float* y, size_t n, size_t i, float area) {
+    for (; i + 1 < n; ++i) {
+        area += x[i] * y[i + 1];
+        area -= x[i + 1] * y[i];
+    }
+    area += x[n - 1] * y[0];
+    area -= x[0] * y[n - 1];
+    return area;
+}
+
+// Helper: Adds the lengths of edges i..n-2 and the closing edge to length
+static float length_tail_aos(const Point* p, size_t n, size_t i, float length) {
+    for (; i + 1 < n; ++i) {
+        length += compute_distance(&p[i], &p[i + 1]);
+    }
+    return length + compute_distance(&p[n - 1], &p[0]);
+}
+
+static float edge_length_soa(const float* x, const float* y, const float* z, size_t i, size_t j) {
+    float dx = x[i] - x[j], dy = y[i] - y[j];
+    float sq = dx*dx + dy*dy;
+    if (z) {
+        float dz = z[i] - z[j];
+        sq += dz*dz;
+    }
+    return sqrtf(sq);
+}
+
+static float length_tail_soa(const float* x, const float* y, const float* z, size_t n, size_t i, float length) {
+    for (; i + 1 < n; ++i) {
+        length += edge_length_soa(x, y, z, i, i + 1);
+    }
+    return length + edge_length_soa(x, y, z, n - 1, 0);
+}
+
+static float shoelace_aos_scalar(const Point* p, size_t n) {
+    return shoelace_tail_aos(p, n, 0, 0.0f);
+}
+
+static float shoelace_soa_scalar(const float* x, const float* y, size_t n) {
+    return shoelace_tail_soa(x, y, n, 0, 0.0f);
+}
+
+static float length_aos_scalar(const Point* p, size_t n) {
+    return length_tail_aos(p, n, 0, 0.0f);
+}
+
+static float length_soa_scalar(const float* x, const float* y, const float* z, size_t n) {
+    return length_tail_soa(x, y, z, n, 0, 0.0f);
+}
+
+static const SimdKernels scalar_kernels = {
+    shoelace_aos_scalar, shoelace_soa_scalar, length_aos_scalar, length_soa_scalar
+};
+
+#if SIMD_X86
+// Helper: Loads 4 packed Points (12 floats) and transposes them into x, y and z vectors
+__attribute__((target("sse2")))
+static inline void load4_aos(const Point* p, __m128* x, __m128* y, __m128* z) {
+    const float* f = &p->x;
+    __m128 a = _mm_loadu_ps(f);      // x0 y0 z0 x1
+    __m128 b = _mm_loadu_ps(f + 4);  // y1 z1 x2 y2
+    __m128 c = _mm_loadu_ps(f + 8);  // z2 x3 y3 z3
+    *x = _mm_shuffle_ps(_mm_shuffle_ps(a, b, LANES(0, 3, 2, 2)), _mm_shuffle_ps(b, c, LANES(2, 2, 1, 1)),
+                        LANES(0, 1, 0, 2));
+    *y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, LANES(1, 1, 0, 0)), _mm_shuffle_ps(b, c, LANES(3, 3, 2, 2)),
+                        LANES(0, 2, 0, 2));
+    *z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, LANES(2, 2, 1, 1)), _mm_shuffle_ps(c, c, LANES(0, 0, 3, 3)),
+                        LANES(0, 2, 0, 2));
+}
+
+// SSE kernels: 4 edges per step. Edge i reads point i+1, so the vector loop stops before the
+// last point and the remaining edges plus the closing edge go through the scalar tail.
+__attribute__((target("sse2")))
+static float shoelace_aos_sse(const Point* p, size_t n) {
+    __m128 acc = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 < n; i += 4) {
+        __m128 xi, yi, zi, xj, yj, zj;
+        load4_aos(p + i, &xi, &yi, &zi);
+        load4_aos(p + i + 1, &xj, &yj, &zj);
+        acc = _mm_add_ps(acc, _mm_mul_ps(xi, yj));
+        acc = _mm_sub_ps(acc, _mm_mul_ps(xj, yi));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    return shoelace_tail_aos(p, n, i, sum_lanes(lanes, 4));
+}
+
+__attribute__((target("sse2")))
+static float shoelace_soa_sse(const float* x, const float* y, size_t n) {
+    __m128 acc = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 < n; i += 4) {
+        __m128 xi = _mm_loadu_ps(x + i), yi = _mm_loadu_ps(y + i);
+        __m128 xj = _mm_loadu_ps(x + i + 1), yj = _mm_loadu_ps(y + i + 1);
+        acc = _mm_add_ps(acc, _mm_mul_ps(xi, yj));
+        acc = _mm_sub_ps(acc, _mm_mul_ps(xj, yi));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    return shoelace_tail_soa(x, y, n, i, sum_lanes(lanes, 4));
+}
+
+__attribute__((target("sse2")))
+static float length_aos_sse(const Point* p, size_t n) {
+    __m128 acc = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 < n; i += 4) {
+        __m128 xi, yi, zi, xj, yj, zj;
+        load4_aos(p + i, &xi, &yi, &zi);
+        load4_aos(p + i + 1, &xj, &yj, &zj);
+        __m128 dx = _mm_sub_ps(xi, xj), dy = _mm_sub_ps(yi, yj), dz = _mm_sub_ps(zi, zj);
+        __m128 sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        acc = _mm_add_ps(acc, _mm_sqrt_ps(sq));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    return length_tail_aos(p, n, i, sum_lanes(lanes, 4));
+}
+
+__attribute__((target("sse2")))
+static float length_soa_sse(const float* x, const float* y, const float* z, size_t n) {
+    __m128 acc = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 < n; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(x + i + 1));
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), _mm_loadu_ps(y + i + 1));
+        __m128 sq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        if (z) {
+            __m128 dz = _mm_sub_ps(_mm_loadu_ps(z + i), _mm_loadu_ps(z + i + 1));
+            sq = _mm_add_ps(sq, _mm_mul_ps(dz, dz));
+        }
+        acc = _mm_add_ps(acc, _mm_sqrt_ps(sq));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    return length_tail_soa(x, y, z, n, i, sum_lanes(lanes, 4));
+}
+
+// Helper: Loads 8 packed Points as two 4-point transposes joined into 256-bit vectors
+__attribute__((target("avx2")))
+static inline void load8_aos(const Point* p, __m256* x, __m256* y, __m256* z) {
+    __m128 x0, y0, z0, x1, y1, z1;
+    load4_aos(p, &x0, &y0, &z0);
+    load4_aos(p + 4, &x1, &y1, &z1);
+    *x = _mm256_insertf128_ps(_mm256_castps128_ps256(x0), x1, 1);
+    *y = _mm256_insertf128_ps(_mm256_castps128_ps256(y0), y1, 1);
+    *z = _mm256_insertf128_ps(_mm256_castps128_ps256(z0), z1, 1);
+}
+
+// AVX2 kernels: 8 edges per step, same tail handling as SSE
+__attribute__((target("avx2")))
+static float shoelace_aos_avx2(const Point* p, size_t n) {
+    __m256 acc = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 < n; i += 8) {
+        __m256 xi, yi, zi, xj, yj, zj;
+        load8_aos(p + i, &xi, &yi, &zi);
+        load8_aos(p + i + 1, &xj, &yj, &zj);
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(xi, yj));
+        acc = _mm256_sub_ps(acc, _mm256_mul_ps(xj, yi));
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, acc);
+    return shoelace_tail_aos(p, n, i, sum_lanes(lanes, 8));
+}
+
+__attribute__((target("avx2")))
+static float shoelace_soa_avx2(const float* x, const float* y, size_t n) {
+    __m256 acc = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 < n; i += 8) {
+        __m256 xi = _mm256_loadu_ps(x + i), yi = _mm256_loadu_ps(y + i);
+        __m256 xj = _mm256_loadu_ps(x + i + 1), yj = _mm256_loadu_ps(y + i + 1);
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(xi, yj));
+        acc = _mm256_sub_ps(acc, _mm256_mul_ps(xj, yi));
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, acc);
+    return shoelace_tail_soa(x, y, n, i, sum_lanes(lanes, 8));
+}
+
+__attribute__((target("avx2")))
+static float length_aos_avx2(const Point* p, size_t n) {
+    __m256 acc = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 < n; i += 8) {
+        __m256 xi, yi, zi, xj, yj, zj;
+        load8_aos(p + i, &xi, &yi, &zi);
+        load8_aos(p + i + 1, &xj, &yj, &zj);
+        __m256 dx = _mm256_sub_ps(xi, xj), dy = _mm256_sub_ps(yi, yj), dz = _mm256_sub_ps(zi, zj);
+        __m256 sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                  _mm256_mul_ps(dz, dz));
+        acc = _mm256_add_ps(acc, _mm256_sqrt_ps(sq));
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, acc);
+    return length_tail_aos(p, n, i, sum_lanes(lanes, 8));
+}
+
+__attribute__((target("avx2")))
+static float length_soa_avx2(const float* x, const float* y, const float* z, size_t n) {
+    __m256 acc = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 < n; i += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(x + i + 1));
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), _mm256_loadu_ps(y + i + 1));
+        __m256 sq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        if (z) {
+            __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(z + i), _mm256_loadu_ps(z + i + 1));
+            sq = _mm256_add_ps(sq, _mm256_mul_ps(dz, dz));
+        }
+        acc = _mm256_add_ps(acc, _mm256_sqrt_ps(sq));
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, acc);
+    return length_tail_soa(x, y, z, n, i, sum_lanes(lanes, 8));
+}
+
+static const SimdKernels sse_kernels = {
+    shoelace_aos_sse, shoelace_soa_sse, length_aos_sse, length_soa_sse
+};
+
+static const SimdKernels avx2_kernels = {
+    shoelace_aos_avx2, shoelace_soa_avx2, length_aos_avx2, length_soa_avx2
+};
+#endif
+
+static pthread_once_t simd_once = PTHREAD_ONCE_INIT;
+static SimdLevel detected_level = SIMD_SCALAR;
+static SimdLevel active_level = SIMD_SCALAR;
+static const SimdKernels* active = &scalar_kernels;
+
+// Helper: Points the dispatch table at the kernels for level
+static void select_kernels(SimdLevel level) {
+    active_level = level;
+    active = &scalar_kernels;
+#if SIMD_X86
+    if (level == SIMD_AVX2) active = &avx2_kernels;
+    else if (level == SIMD_SSE) active = &sse_kernels;
+#endif
+}
+
+// Helper: One-time CPU detection; starts on the best supported level
+static void simd_init(void) {
+#if SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) detected_level = SIMD_AVX2;
+    else if (__builtin_cpu_supports("sse2")) detected_level = SIMD_SSE;
+#endif
+    select_kernels(detected_level);
+}
+
+/**
+ * @brief Returns the best SIMD level supported by the running CPU.
+ * @return Detected level (SIMD_SCALAR on non-x86 builds).
+ */
+SimdLevel simd_detect_level(void) {
+    pthread_once(&simd_once, simd_init);
+    return detected_level;
+}
+
+/**
+ * @brief Selects the kernels used by the metric functions (for benchmarks and tests).
+ *
+ * Not thread-safe: call it before starting work that computes metrics.
+ * @param level Requested level; clamped to what the CPU supports.
+ * @return Level now in use.
+ */
+SimdLevel simd_set_level(SimdLevel level) {
+    pthread_once(&simd_once, simd_init);
+    if (level < SIMD_SCALAR) level = SIMD_SCALAR;
+    if (level > detected_level) level = detected_level;
+    select_kernels(level);
+    return active_level;
+}
+
+/**
+ * @brief Returns the SIMD level currently in use.
+ * @return Active level.
+ */
+SimdLevel simd_get_level(void) {
+    pthread_once(&simd_once, simd_init);
+    return active_level;
+}
+
+/**
+ * @brief Returns a printable name for a SIMD level.
+ * @param level The level.
+ * @return "scalar", "sse" or "avx2".
+ */
+const char* simd_level_name(SimdLevel level) {
+    switch (level) {
+        case SIMD_AVX2: return "avx2";
+        case SIMD_SSE: return "sse";
+        default: return "scalar";
+    }
+}
+
+/**
+ * @brief Shoelace sum over a closed polygon of packed Points.
+ * @param points Polygon vertices.
+ * @param n Vertex count.
+ * @return Twice the signed area (0 if n is 0).
+ */
+float simd_shoelace_aos(const Point* points, size_t n) {
+    if (n == 0) return 0.0f;
+    pthread_once(&simd_once, simd_init);
+    return active->shoelace_aos(points, n);
+}
+
+/**
+ * @brief Shoelace sum over a closed polygon stored as coordinate arrays.
+ * @param x, y Vertex coordinates.
+ * @param n Vertex count.
+ * @return Twice the signed area (0 if n is 0).
+ */
+float simd_shoelace_soa(const float* x, const float* y, size_t n) {
+    if (n == 0) return 0.0f;
+    pthread_once(&simd_once, simd_init);
+    return active->shoelace_soa(x, y, n);
+}
+
+/**
+ * @brief Length of the closed path through packed Points (3D distances, z = 0 in 2D).
+ * @param points Path vertices.
+ * @param n Vertex count.
+ * @return Total length including the closing edge (0 if n is 0).
+ */
+float simd_path_length_aos(const Point* points, size_t n) {
+    if (n == 0) return 0.0f;
+    pthread_once(&simd_once, simd_init);
+    return active->length_aos(points, n);
+}
+
+/**
+ * @brief Length of the closed path through points stored as coordinate arrays.
+ * @param x, y, z Vertex coordinates (z may be NULL for 2D).
+ * @param n Vertex count.
+ * @return Total length including the closing edge (0 if n is 0).
+ */
+float simd_path_length_soa(const float* x, const float* y, const float* z, size_t n) {
+    if (n == 0) return 0.0f;
+    pthread_once(&simd_once, simd_init);
+    return active->length_soa(x, y, z, n);
+}
+
+// Double-precision accumulation. Terms are produced one block at a time into a small buffer
+// (products of floats are exact in double, so every term is rounded once) and then summed
+// with the selected mode. Terms are bit-identical at every level; only summation order varies.
+
+#define ACCUM_BLOCK 256  // Terms per block, also the pairwise leaf size
+#define ACCUM_LANES 4    // Running sums kept per mode (one per AVX2 double lane)
+#define PAIRWISE_DEPTH 64  // Enough for 2^64 blocks
+
+// Edge term source: a scalar term for edge (i, j) plus a block generator for edges start..start+count-1
+typedef struct EdgeSource EdgeSource;
+struct EdgeSource {
+    const Point* points;
+    const float* x;
+    const float* y;
+    const float* z;
+    double (*term)(const EdgeSource* src, size_t i, size_t j);
+    void (*block)(const EdgeSource* src, size_t start, size_t count, double* out);
+};
+
+// Running state for one accumulation
+typedef struct {
+    AccumMode mode;
+    double sum[ACCUM_LANES];   // Per-lane sums (double, Kahan)
+    double comp[ACCUM_LANES];  // Per-lane Kahan compensations
+    double stack[PAIRWISE_DEPTH];  // Pairwise partial sums, one per set bit of blocks
+    size_t depth;
+    size_t blocks;
+} Accumulator;
+
+static double area_term_aos(const EdgeSource* src, size_t i, size_t j) {
+    const Point* p = src->points;
+    return (double)p[i].x * p[j].y - (double)p[j].x * p[i].y;
+}
+
+static double area_term_soa(const EdgeSource* src, size_t i, size_t j) {
+    return (double)src->x[i] * src->y[j] - (double)src->x[j] * src->y[i];
+}
+
+static double length_term_aos(const EdgeSource* src, size_t i, size_t j) {
+    const Point* p = src->points;
+    double dx = (double)p[i].x - p[j].x, dy = (double)p[i].y - p[j].y, dz = (double)p[i].z - p[j].z;
+    return sqrt(dx*dx + dy*dy + dz*dz);
+}
+
+static double length_term_soa(const EdgeSource* src, size_t i, size_t j) {
+    double dx = (double)src->x[i] - src->x[j], dy = (double)src->y[i] - src->y[j];
+    double sq = dx*dx + dy*dy;
+    if (src->z) {
+        double dz = (double)src->z[i] - src->z[j];
+        sq += dz*dz;
+    }
+    return sqrt(sq);
+}
+
+static void terms_scalar(const EdgeSource* src, size_t start, size_t count, double* out) {
+    for (size_t k = 0; k < count; ++k) out[k] = src->term(src, start + k, start + k + 1);
+}
+
+// Helper: Kahan step on one running sum
+static void kahan_add(double* sum, double* comp, double value) {
+    double y = value - *comp;
+    double t = *sum + y;
+    *comp = (t - *sum) - y;
+    *sum = t;
+}
+
+// Helper: Adds a finished block sum to the pairwise stack (a binary counter over blocks, so
+// partial sums are only ever added to partial sums of the same size)
+static void pairwise_push(Accumulator* acc, double value) {
+    size_t b = ++acc->blocks;
+    while ((b & 1) == 0 && acc->depth > 0) {
+        value = acc->stack[--acc->depth] + value;
+        b >>= 1;
+    }
+    acc->stack[acc->depth++] = value;
+}
+
+static void accum_block_scalar(Accumulator* acc, const double* t, size_t n) {
+    if (acc->mode == ACCUM_KAHAN) {
+        for (size_t k = 0; k < n; ++k) kahan_add(&acc->sum[0], &acc->comp[0], t[k]);
+    } else if (acc->mode == ACCUM_PAIRWISE) {
+        double lanes[ACCUM_LANES] = {0.0, 0.0, 0.0, 0.0};
+        for (size_t k = 0; k < n; ++k) lanes[k % ACCUM_LANES] += t[k];
+        pairwise_push(acc, (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+    } else {
+        for (size_t k = 0; k < n; ++k) acc->sum[0] += t[k];
+    }
+}
+
+#if SIMD_X86
+__attribute__((target("avx2")))
+static void area_terms_aos_avx2(const EdgeSource* src, size_t start, size_t count, double* out) {
+    size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+        __m128 xi, yi, zi, xj, yj, zj;
+        load4_aos(src->points + start + k, &xi, &yi, &zi);
+        load4_aos(src->points + start + k + 1, &xj, &yj, &zj);
+        __m256d a = _mm256_mul_pd(_mm256_cvtps_pd(xi), _mm256_cvtps_pd(yj));
+        __m256d b = _mm256_mul_pd(_mm256_cvtps_pd(xj), _mm256_cvtps_pd(yi));
+        _mm256_storeu_pd(out + k, _mm256_sub_pd(a, b));
+    }
+    for (; k < count; ++k) out[k] = area_term_aos(src, start + k, start + k + 1);
+}
+
+__attribute__((target("avx2")))
+static void area_terms_soa_avx2(const EdgeSource* src, size_t start, size_t count, double* out) {
+    const float* x = src->x + start;
+    const float* y = src->y + start;
+    size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+        __m256d a = _mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(x + k)), _mm256_cvtps_pd(_mm_loadu_ps(y + k + 1)));
+        __m256d b = _mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(x + k + 1)), _mm256_cvtps_pd(_mm_loadu_ps(y + k)));
+        _mm256_storeu_pd(out + k, _mm256_sub_pd(a, b));
+    }
+    for (; k < count; ++k) out[k] = area_term_soa(src, start + k, start + k + 1);
+}
+
+__attribute__((target("avx2")))
+static void length_terms_aos_avx2(const EdgeSource* src, size_t start, size_t count, double* out) {
+    size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+        __m128 xi, yi, zi, xj, yj, zj;
+        load4_aos(src->points + start + k, &xi, &yi, &zi);
+        load4_aos(src->points + start + k + 1, &xj, &yj, &zj);
+        __m256d dx = _mm256_sub_pd(_mm256_cvtps_pd(xi), _mm256_cvtps_pd(xj));
+        __m256d dy = _mm256_sub_pd(_mm256_cvtps_pd(yi), _mm256_cvtps_pd(yj));
+        __m256d dz = _mm256_sub_pd(_mm256_cvtps_pd(zi), _mm256_cvtps_pd(zj));
+        __m256d sq = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)),
+                                   _mm256_mul_pd(dz, dz));
+        _mm256_storeu_pd(out + k, _mm256_sqrt_pd(sq));
+    }
+    for (; k < count; ++k) out[k] = length_term_aos(src, start + k, start + k + 1);
+}
+
+__attribute__((target("avx2")))
+static void length_terms_soa_avx2(const EdgeSource* src, size_t start, size_t count, double* out) {
+    const float* x = src->x + start;
+    const float* y = src->y + start;
+    const float* z = src->z ? src->z + start : NULL;
+    size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+        __m256d dx = _mm256_sub_pd(_mm256_cvtps_pd(_mm_loadu_ps(x + k)), _mm256_cvtps_pd(_mm_loadu_ps(x + k + 1)));
+        __m256d dy = _mm256_sub_pd(_mm256_cvtps_pd(_mm_loadu_ps(y + k)), _mm256_cvtps_pd(_mm_loadu_ps(y + k + 1)));
+        __m256d sq = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        if (z) {
+            __m256d dz = _mm256_sub_pd(_mm256_cvtps_pd(_mm_loadu_ps(z + k)), _mm256_cvtps_pd(_mm_loadu_ps(z + k + 1)));
+            sq = _mm256_add_pd(sq, _mm256_mul_pd(dz, dz));
+        }
+        _mm256_storeu_pd(out + k, _mm256_sqrt_pd(sq));
+    }
+    for (; k < count; ++k) out[k] = length_term_soa(src, start + k, start + k + 1);
+}
+
+// Helper: Sums a block 4 lanes at a time; a ragged end goes into the scalar path
+__attribute__((target("avx2")))
+static void accum_block_avx2(Accumulator* acc, const double* t, size_t n) {
+    size_t vec = n - n % ACCUM_LANES;
+    if (acc->mode == ACCUM_KAHAN) {
+        __m256d sum = _mm256_loadu_pd(acc->sum), comp = _mm256_loadu_pd(acc->comp);
+        for (size_t k = 0; k < vec; k += ACCUM_LANES) {
+            __m256d y = _mm256_sub_pd(_mm256_loadu_pd(t + k), comp);
+            __m256d s = _mm256_add_pd(sum, y);
+            comp = _mm256_sub_pd(_mm256_sub_pd(s, sum), y);
+            sum = s;
+        }
+        _mm256_storeu_pd(acc->sum, sum);
+        _mm256_storeu_pd(acc->comp, comp);
+    } else if (acc->mode == ACCUM_PAIRWISE) {
+        __m256d sum = _mm256_setzero_pd();
+        for (size_t k = 0; k < vec; k += ACCUM_LANES) sum = _mm256_add_pd(sum, _mm256_loadu_pd(t + k));
+        double lanes[ACCUM_LANES];
+        _mm256_storeu_pd(lanes, sum);
+        for (size_t k = vec; k < n; ++k) lanes[k % ACCUM_LANES] += t[k];
+        pairwise_push(acc, (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+        return;
+    } else {
+        __m256d sum = _mm256_loadu_pd(acc->sum);
+        for (size_t k = 0; k < vec; k += ACCUM_LANES) sum = _mm256_add_pd(sum, _mm256_loadu_pd(t + k));
+        _mm256_storeu_pd(acc->sum, sum);
+    }
+    accum_block_scalar(acc, t + vec, n - vec);
+}
+#endif
+
+// Helper: Runs all edges of a closed polyline through the accumulator and returns the total
+static double accumulate_edges(EdgeSource* src, void (*block_avx2)(const EdgeSource*, size_t, size_t, double*),
+                               size_t n, AccumMode mode) {
+    pthread_once(&simd_once, simd_init);
+    void (*accum_block)(Accumulator*, const double*, size_t) = accum_block_scalar;
+    src->block = terms_scalar;
+#if SIMD_X86
+    if (active_level >= SIMD_AVX2) {
+        accum_block = accum_block_avx2;
+        src->block = block_avx2;
+    }
+#else
+    (void)block_avx2;
+#endif
+
+    Accumulator acc = {0};
+    acc.mode = mode;
+    double terms[ACCUM_BLOCK];
+    for (size_t start = 0; start + 1 < n; start += ACCUM_BLOCK) {
+        size_t count = n - 1 - start < ACCUM_BLOCK ? n - 1 - start : ACCUM_BLOCK;
+        src->block(src, start, count, terms);
+        accum_block(&acc, terms, count);
+    }
+    terms[0] = src->term(src, n - 1, 0);  // Closing edge
+    accum_block(&acc, terms, 1);
+
+    double total = 0.0;
+    if (mode == ACCUM_PAIRWISE) {
+        for (size_t d = acc.depth; d-- > 0; ) total += acc.stack[d];  // Smallest partials first
+    } else if (mode == ACCUM_KAHAN) {
+        double comp = 0.0;
+        for (size_t k = 0; k < ACCUM_LANES; ++k) {
+            kahan_add(&total, &comp, acc.sum[k]);
+            kahan_add(&total, &comp, -acc.comp[k]);
+        }
+    } else {
+        for (size_t k = 0; k < ACCUM_LANES; ++k) total += acc.sum[k];
+    }
+    return total;
+}
+
+/**
+ * @brief Shoelace sum over packed Points with double-precision accumulation.
+ * @param points Polygon vertices.
+ * @param n Vertex count.
+ * @param mode Accumulation mode (ACCUM_FLOAT uses the float kernels).
+ * @return Twice the signed area (0 if n is 0).
+ */
+double simd_shoelace_accum_aos(const Point* points, size_t n, AccumMode mode) {
+    if (n == 0) return 0.0;
+    if (mode == ACCUM_FLOAT) return simd_shoelace_aos(points, n);
+    EdgeSource src = {points, NULL, NULL, NULL, area_term_aos, NULL};
+#if SIMD_X86
+    return accumulate_edges(&src, area_terms_aos_avx2, n, mode);
+#else
+    return accumulate_edges(&src, NULL, n, mode);
+#endif
+}
+
+/**
+ * @brief Shoelace sum over coordinate arrays with double-precision accumulation.
+ * @param x, y Vertex coordinates.
+ * @param n Vertex count.
+ * @param mode Accumulation mode (ACCUM_FLOAT uses the float kernels).
+ * @return Twice the signed area (0 if n is 0).
+ */
+double simd_shoelace_accum_soa(const float* x, const float* y, size_t n, AccumMode mode) {
+    if (n == 0) return 0.0;
+    if (mode == ACCUM_FLOAT) return simd_shoelace_soa(x, y, n);
+    EdgeSource src = {NULL, x, y, NULL, area_term_soa, NULL};
+#if SIMD_X86
+    return accumulate_edges(&src, area_terms_soa_avx2, n, mode);
+#else
+    return accumulate_edges(&src, NULL, n, mode);
+#endif
+}
+
+/**
+ * @brief Closed path length over packed Points with double-precision accumulation.
+ * @param points Path vertices.
+ * @param n Vertex count.
+ * @param mode Accumulation mode (ACCUM_FLOAT uses the float kernels).
+ * @return Total length including the closing edge (0 if n is 0).
+ */
+double simd_path_length_accum_aos(const Point* points, size_t n, AccumMode mode) {
+    if (n == 0) return 0.0;
+    if (mode == ACCUM_FLOAT) return simd_path_length_aos(points, n);
+    EdgeSource src = {points, NULL, NULL, NULL, length_term_aos, NULL};
+#if SIMD_X86
+    return accumulate_edges(&src, length_terms_aos_avx2, n, mode);
+#else
+    return accumulate_edges(&src, NULL, n, mode);
+#endif
+}
+
+/**
+ * @brief Closed path length over coordinate arrays with double-precision accumulation.
+ * @param x, y, z Vertex coordinates (z may be NULL for 2D).
+ * @param n Vertex count.
+ * @param mode Accumulation mode (ACCUM_FLOAT uses the float kernels).
+ * @return Total length including the closing edge (0 if n is 0).
+ */
+double simd_path_length_accum_soa(const float* x, const float* y, const float* z, size_t n, AccumMode mode) {
+    if (n == 0) return 0.0;
+    if (mode == ACCUM_FLOAT) return simd_path_length_soa(x, y, z, n);
+    EdgeSource src = {NULL, x, y, z, length_term_soa, NULL};
+#if SIMD_X86
+    return accumulate_edges(&src, length_terms_soa_avx2, n, mode);
+#else
+    return accumulate_edges(&src, NULL, n, mode);
+#endif
+}
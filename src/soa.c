@@ -0,0 +1,203 @@
+#define _POSIX_C_SOURCE 200112L  // For posix_memalign
+
+#include "pointset_soa.h"
+#include "simd.h"
+#include "cull.h"
+#include <stdlib.h>  // For posix_memalign, malloc, free
+#include <math.h>    // For fabsf, fabs
+#include <stdio.h>   // For fprintf, stderr
+#include <string.h>  // For memcpy
+
+// Helper: Allocates an aligned coordinate array (at least one element so empty sets stay valid)
+static float* alloc_coords(size_t count) {
+    void* ptr = NULL;
+    if (posix_memalign(&ptr, SOA_ALIGNMENT, (count > 0 ? count : 1) * sizeof(float)) != 0) return NULL;
+    return ptr;
+}
+
+/**
+ * @brief Allocates an SoA point set with uninitialized coordinates.
+ * @param count Number of points.
+ * @param is_3d 1 to allocate a z array, 0 for 2D.
+ * @return New PointSetSoA, or NULL on failure.
+ */
+PointSetSoA* create_points_soa(size_t count, int is_3d) {
+    PointSetSoA* soa = malloc(sizeof(PointSetSoA));
+    if (!soa) {
+        fprintf(stderr, "Memory allocation failed for SoA points\n");
+        return NULL;
+    }
+    soa->x = alloc_coords(count);
+    soa->y = alloc_coords(count);
+    soa->z = is_3d ? alloc_coords(count) : NULL;
+    soa->count = count;
+    soa->is_3d = is_3d;
+    if (!soa->x || !soa->y || (is_3d && !soa->z)) {
+        fprintf(stderr, "Memory allocation failed for SoA points\n");
+        free_points_soa(soa);
+        return NULL;
+    }
+    return soa;
+}
+
+/**
+ * @brief Converts an array-of-structs PointSet to SoA layout.
+ * @param set Input PointSet.
+ * @return New PointSetSoA (z dropped for 2D sets), or NULL on failure.
+ */
+PointSetSoA* points_to_soa(const PointSet* set) {
+    if (!set) return NULL;
+    PointSetSoA* soa = create_points_soa(set->count, set->is_3d);
+    if (!soa) return NULL;
+    for (size_t i = 0; i < set->count; ++i) {
+        soa->x[i] = set->points[i].x;
+        soa->y[i] = set->points[i].y;
+    }
+    if (soa->z) {
+        for (size_t i = 0; i < set->count; ++i) soa->z[i] = set->points[i].z;
+    }
+    return soa;
+}
+
+/**
+ * @brief Converts an SoA point set back to an array-of-structs PointSet.
+ * @param soa Input PointSetSoA.
+ * @return New PointSet (z = 0 for 2D sets), or NULL on failure.
+ */
+PointSet* soa_to_points(const PointSetSoA* soa) {
+    if (!soa) return NULL;
+    PointSet* set = malloc(sizeof(PointSet));
+    if (!set) {
+        fprintf(stderr, "Memory allocation failed for points\n");
+        return NULL;
+    }
+    set->points = malloc((soa->count > 0 ? soa->count : 1) * sizeof(Point));
+    if (!set->points) {
+        free(set);
+        fprintf(stderr, "Memory allocation failed for points\n");
+        return NULL;
+    }
+    for (size_t i = 0; i < soa->count; ++i) {
+        set->points[i].x = soa->x[i];
+        set->points[i].y = soa->y[i];
+        set->points[i].z = soa->z ? soa->z[i] : 0.0f;
+    }
+    set->count = soa->count;
+    set->is_3d = soa->is_3d;
+    return set;
+}
+
+/**
+ * @brief Frees an SoA point set.
+ * @param soa The PointSetSoA to free (may be NULL).
+ */
+void free_points_soa(PointSetSoA* soa) {
+    if (soa) {
+        free(soa->x);
+        free(soa->y);
+        free(soa->z);
+        free(soa);
+    }
+}
+
+/**
+ * @brief Finds the Graham scan pivot: the lowest point, leftmost among ties.
+ * @param soa Input PointSetSoA (non-empty).
+ * @return Index of the pivot (0 for an empty or NULL set).
+ */
+size_t find_pivot_soa(const PointSetSoA* soa) {
+    if (!soa || soa->count == 0) return 0;
+    const float* x = soa->x;
+    const float* y = soa->y;
+    size_t min_idx = 0;
+    for (size_t i = 1; i < soa->count; ++i) {
+        if (y[i] < y[min_idx] || (y[i] == y[min_idx] && x[i] < x[min_idx])) {
+            min_idx = i;
+        }
+    }
+    return min_idx;
+}
+
+/**
+ * @brief Removes points strictly inside the Akl-Toussaint octagon (SoA variant).
+ *
+ * Same octagon and error-bounded edge test as cull_interior_points, so the survivors are
+ * identical; the scan reads only the x and y arrays.
+ * @param soa Input PointSetSoA.
+ * @return New PointSetSoA with the surviving points (same order), or NULL on failure.
+ */
+PointSetSoA* cull_interior_points_soa(const PointSetSoA* soa) {
+    if (!soa) return NULL;
+    PointSetSoA* out = create_points_soa(soa->count, soa->is_3d);
+    if (!out) return NULL;
+
+    const float* x = soa->x;
+    const float* y = soa->y;
+    const float* z = soa->z;
+    CullOctagon octagon;
+    size_t corner_count = soa->count > 0 ? find_cull_octagon(x, y, 1, soa->count, &octagon) : 0;
+    if (corner_count < 3) {
+        // Degenerate octagon: nothing is strictly inside
+        memcpy(out->x, x, soa->count * sizeof(float));
+        memcpy(out->y, y, soa->count * sizeof(float));
+        if (z) memcpy(out->z, z, soa->count * sizeof(float));
+        return out;
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < soa->count; ++i) {
+        float xi = x[i], yi = y[i];
+        int inside = cull_octagon_inside(&octagon, xi, yi);
+        out->x[kept] = xi;
+        out->y[kept] = yi;
+        if (z) out->z[kept] = z[i];
+        kept += (size_t)!inside;
+    }
+    out->count = kept;
+    return out;
+}
+
+/**
+ * @brief Computes the area of a 2D polygon using the shoelace formula (SoA variant).
+ *
+ * Uses the same SIMD kernels and summation order as compute_area, so both layouts give
+ * identical results.
+ * @param hull The PointSetSoA (assumed 2D polygon).
+ * @return Area (float), or -1 on invalid input.
+ */
+float compute_area_soa(const PointSetSoA* hull) {
+    if (!hull || hull->count < 3) return -1.0f;
+    return fabsf(simd_shoelace_soa(hull->x, hull->y, hull->count)) / 2.0f;
+}
+
+/**
+ * @brief Computes the closed path length around the hull (SoA variant).
+ * @param hull The PointSetSoA.
+ * @return Total length (float), or -1 on invalid input.
+ */
+float compute_path_length_soa(const PointSetSoA* hull) {
+    if (!hull || hull->count < 2) return -1.0f;
+    return simd_path_length_soa(hull->x, hull->y, hull->z, hull->count);
+}
+
+/**
+ * @brief Computes the polygon area with a selectable accumulation mode (SoA variant).
+ * @param hull The PointSetSoA (assumed 2D polygon).
+ * @param mode Accumulation mode.
+ * @return Area, or -1 on invalid input.
+ */
+double compute_area_soa_accum(const PointSetSoA* hull, AccumMode mode) {
+    if (!hull || hull->count < 3) return -1.0;
+    return fabs(simd_shoelace_accum_soa(hull->x, hull->y, hull->count, mode)) / 2.0;
+}
+
+/**
+ * @brief Computes the closed path length with a selectable accumulation mode (SoA variant).
+ * @param hull The PointSetSoA.
+ * @param mode Accumulation mode.
+ * @return Total length, or -1 on invalid input.
+ */
+double compute_path_length_soa_accum(const PointSetSoA* hull, AccumMode mode) {
+    if (!hull || hull->count < 2) return -1.0;
+    return simd_path_length_accum_soa(hull->x, hull->y, hull->z, hull->count, mode);
+}
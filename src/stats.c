@@ -0,0 +1,162 @@
+#define _POSIX_C_SOURCE 200809L  // For clock_gettime under -std=c99
+
+#include "stats.h"
+#include <time.h>    // For clock_gettime
+#include <sys/resource.h>  // For getrusage
+
+static int enabled = 0;
+static uint64_t phase_ns[STATS_PHASE_COUNT];  // Updated atomically: phases may end on several threads
+static uint64_t counters[STATS_COUNTER_COUNT];
+
+/**
+ * @brief Reads the monotonic wall clock.
+ *
+ * Unlike clock(), which sums CPU time over all threads, this measures elapsed time, so
+ * multithreaded runs are timed as the user experiences them.
+ * @return Milliseconds since an arbitrary fixed point.
+ */
+double stats_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+/**
+ * @brief Turns phase timing and counters on or off.
+ * @param on Non-zero to record phases and counters.
+ */
+void stats_enable(int on) {
+    __atomic_store_n(&enabled, on != 0, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Reports whether phase timing is on.
+ * @return Non-zero when enabled.
+ */
+int stats_enabled(void) {
+    return __atomic_load_n(&enabled, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Clears every phase total and counter.
+ */
+void stats_reset(void) {
+    for (int p = 0; p < STATS_PHASE_COUNT; ++p) {
+        __atomic_store_n(&phase_ns[p], 0, __ATOMIC_RELAXED);
+    }
+    for (int c = 0; c < STATS_COUNTER_COUNT; ++c) {
+        __atomic_store_n(&counters[c], 0, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief Starts timing a phase.
+ * @return Start stamp to pass to stats_phase_end, or 0 when timing is off (no clock read).
+ */
+double stats_phase_begin(void) {
+    return stats_enabled() ? stats_now_ms() : 0.0;
+}
+
+/**
+ * @brief Adds the time since start to a phase total.
+ * @param phase Phase to charge.
+ * @param start Stamp from stats_phase_begin (0 is ignored).
+ */
+void stats_phase_end(StatsPhase phase, double start) {
+    if (start == 0.0 || (unsigned)phase >= STATS_PHASE_COUNT) return;
+    double elapsed = stats_now_ms() - start;
+    if (elapsed > 0.0) {
+        __atomic_add_fetch(&phase_ns[phase], (uint64_t)(elapsed * 1e6), __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief Total time recorded for a phase since the last reset.
+ * @param phase Phase to read.
+ * @return Milliseconds (0 for an unknown phase).
+ */
+double stats_phase_ms(StatsPhase phase) {
+    if ((unsigned)phase >= STATS_PHASE_COUNT) return 0.0;
+    return __atomic_load_n(&phase_ns[phase], __ATOMIC_RELAXED) / 1e6;
+}
+
+/**
+ * @brief Short lowercase name of a phase, as used in reports.
+ * @param phase Phase.
+ * @return Name, or "unknown".
+ */
+const char* stats_phase_name(StatsPhase phase) {
+    static const char* names[STATS_PHASE_COUNT] = {"load", "cull", "sort", "scan", "metrics", "write"};
+    return ((unsigned)phase < STATS_PHASE_COUNT) ? names[phase] : "unknown";
+}
+
+/**
+ * @brief Adds to a counter.
+ *
+ * Hot loops count into a local and call this once per pass, so the atomic add stays off the
+ * per-element path.
+ * @param counter Counter to increase.
+ * @param amount Amount to add (ignored while stats are disabled).
+ */
+void stats_add(StatsCounter counter, uint64_t amount) {
+    if (amount == 0 || (unsigned)counter >= STATS_COUNTER_COUNT || !stats_enabled()) return;
+    __atomic_add_fetch(&counters[counter], amount, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Current value of a counter since the last reset.
+ * @param counter Counter to read.
+ * @return Its value (0 for an unknown counter).
+ */
+uint64_t stats_counter(StatsCounter counter) {
+    if ((unsigned)counter >= STATS_COUNTER_COUNT) return 0;
+    return __atomic_load_n(&counters[counter], __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Short snake_case name of a counter, as used in reports.
+ * @param counter Counter.
+ * @return Name, or "unknown".
+ */
+const char* stats_counter_name(StatsCounter counter) {
+    static const char* names[STATS_COUNTER_COUNT] = {
+        "points_parsed", "lines_skipped", "points_culled", "comparisons", "hull_pops", "bytes_written",
+        "allocations"
+    };
+    return ((unsigned)counter < STATS_COUNTER_COUNT) ? names[counter] : "unknown";
+}
+
+/**
+ * @brief Peak resident set size of the process so far.
+ *
+ * Read from the kernel rather than tracked, so it covers every allocation and mapping
+ * (mmap'd input included) and is available even while stats are disabled.
+ * @return Kilobytes, or 0 if unavailable.
+ */
+size_t stats_peak_rss_kb(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0 || usage.ru_maxrss < 0) return 0;
+    return (size_t)usage.ru_maxrss;  // Kilobytes on Linux
+}
+
+/**
+ * @brief Writes every phase total and counter as one JSON object.
+ *
+ * Layout: {"phases_ms": {"load": ..., ...}, "total_ms": ..., "peak_rss_kb": ...,
+ * "counters": {"points_parsed": ..., ...}}.
+ * Phases need not add up to the total: it also covers untimed work such as printing.
+ * @param out Destination stream.
+ * @param total_ms Wall time of the whole run, as measured by the caller.
+ */
+void stats_write_json(FILE* out, double total_ms) {
+    fprintf(out, "{\"phases_ms\": {");
+    for (int p = 0; p < STATS_PHASE_COUNT; ++p) {
+        fprintf(out, "%s\"%s\": %.3f", p ? ", " : "", stats_phase_name((StatsPhase)p), stats_phase_ms((StatsPhase)p));
+    }
+    fprintf(out, "}, \"total_ms\": %.3f, \"peak_rss_kb\": %zu, \"counters\": {", total_ms, stats_peak_rss_kb());
+    for (int c = 0; c < STATS_COUNTER_COUNT; ++c) {
+        fprintf(out, "%s\"%s\": %llu", c ? ", " : "", stats_counter_name((StatsCounter)c),
+                (unsigned long long)stats_counter((StatsCounter)c));
+    }
+    fprintf(out, "}}\n");
+}
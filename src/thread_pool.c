@@ -0,0 +1,306 @@
+#include "thread_pool.h"
+#include <stdlib.h>   // For malloc, free
+#include <stdio.h>    // For fprintf, stderr
+#include <string.h>   // For memcpy
+#include <pthread.h>  // For worker threads
+
+#define QUEUE_INITIAL_CAPACITY 64  // Tasks per queue before the ring buffer grows
+#define NO_QUEUE ((size_t)-1)      // Submitting thread that is not a pool worker
+
+// Completion counter shared by the tasks of one thread_pool_run call
+typedef struct {
+    size_t remaining;  // Updated atomically
+} TaskGroup;
+
+typedef struct {
+    ThreadPoolTask fn;
+    void* arg;
+    TaskGroup* group;
+} Task;
+
+// Ring buffer of tasks: the owner pops the newest, thieves take the oldest
+typedef struct {
+    Task* tasks;
+    size_t head;  // Oldest task
+    size_t count;
+    size_t capacity;
+    pthread_mutex_t lock;
+} TaskQueue;
+
+typedef struct {
+    ThreadPool* pool;
+    size_t index;  // Own queue
+} WorkerArg;
+
+struct ThreadPool {
+    pthread_t* threads;
+    WorkerArg* worker_args;
+    TaskQueue* queues;        // One per requested worker
+    size_t queue_count;
+    size_t workers;           // Threads actually started (only their queues receive tasks)
+    size_t queued;            // Tasks in all queues (atomic)
+    size_t next_queue;        // Round-robin submit cursor (atomic)
+    size_t inline_threshold;
+    int stop;
+    pthread_mutex_t lock;     // Guards stop and the sleep/wake handshake
+    pthread_cond_t work_cond; // Signalled when tasks are queued or the pool stops
+    pthread_cond_t done_cond; // Signalled when a task group completes
+};
+
+// Helper: Appends a task at the owner's end; returns 0, or -1 if the queue could not grow
+static int queue_push(TaskQueue* q, const Task* task) {
+    pthread_mutex_lock(&q->lock);
+    if (q->count == q->capacity) {
+        size_t capacity = q->capacity * 2;
+        Task* grown = malloc(capacity * sizeof(Task));
+        if (!grown) {
+            pthread_mutex_unlock(&q->lock);
+            return -1;
+        }
+        // Unwrap the ring so the oldest task lands at index 0
+        size_t first = q->capacity - q->head < q->count ? q->capacity - q->head : q->count;
+        memcpy(grown, q->tasks + q->head, first * sizeof(Task));
+        memcpy(grown + first, q->tasks, (q->count - first) * sizeof(Task));
+        free(q->tasks);
+        q->tasks = grown;
+        q->head = 0;
+        q->capacity = capacity;
+    }
+    q->tasks[(q->head + q->count) % q->capacity] = *task;
+    q->count++;
+    pthread_mutex_unlock(&q->lock);
+    return 0;
+}
+
+// Helper: Takes the newest task (owner) or the oldest (thief); returns 1 if one was taken
+static int queue_take(TaskQueue* q, int steal, Task* task) {
+    int taken = 0;
+    pthread_mutex_lock(&q->lock);
+    if (q->count > 0) {
+        if (steal) {
+            *task = q->tasks[q->head];
+            q->head = (q->head + 1) % q->capacity;
+        } else {
+            *task = q->tasks[(q->head + q->count - 1) % q->capacity];
+        }
+        q->count--;
+        taken = 1;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return taken;
+}
+
+// Helper: Finds a task, own queue first, then stealing from the others in turn
+static int take_task(ThreadPool* pool, size_t self, Task* task) {
+    if (__atomic_load_n(&pool->queued, __ATOMIC_ACQUIRE) == 0) return 0;
+    size_t start = self;
+    if (self == NO_QUEUE) {
+        start = __atomic_load_n(&pool->next_queue, __ATOMIC_RELAXED) % pool->workers;
+    } else if (queue_take(&pool->queues[self], 0, task)) {
+        __atomic_sub_fetch(&pool->queued, 1, __ATOMIC_ACQ_REL);
+        return 1;
+    }
+    for (size_t k = 0; k < pool->workers; ++k) {
+        size_t victim = (start + k) % pool->workers;
+        if (victim != self && queue_take(&pool->queues[victim], 1, task)) {
+            __atomic_sub_fetch(&pool->queued, 1, __ATOMIC_ACQ_REL);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Helper: Runs a task and wakes the submitter when it was the last of its group
+static void run_task(ThreadPool* pool, const Task* task) {
+    task->fn(task->arg);
+    if (__atomic_sub_fetch(&task->group->remaining, 1, __ATOMIC_ACQ_REL) == 0) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->done_cond);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+// Thread function: runs tasks until the pool stops, sleeping while every queue is empty
+static void* worker_main(void* arg) {
+    WorkerArg* w = (WorkerArg*)arg;
+    ThreadPool* pool = w->pool;
+    pthread_mutex_lock(&pool->lock);  // Wait until thread_pool_create has settled pool->workers
+    pthread_mutex_unlock(&pool->lock);
+    for (;;) {
+        Task task;
+        if (take_task(pool, w->index, &task)) {
+            run_task(pool, &task);
+            continue;
+        }
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->stop && __atomic_load_n(&pool->queued, __ATOMIC_ACQUIRE) == 0) {
+            pthread_cond_wait(&pool->work_cond, &pool->lock);
+        }
+        int done = pool->stop && __atomic_load_n(&pool->queued, __ATOMIC_ACQUIRE) == 0;
+        pthread_mutex_unlock(&pool->lock);
+        if (done) break;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Creates a thread pool.
+ *
+ * Starts num_threads - 1 workers, each with its own task queue; the thread calling
+ * thread_pool_run is the remaining one. If some workers cannot be started the pool runs
+ * with fewer.
+ * @param num_threads Total threads that run tasks, caller included (values below 1 act as 1).
+ * @return New ThreadPool, or NULL on failure.
+ */
+ThreadPool* thread_pool_create(int num_threads) {
+    size_t wanted = num_threads > 1 ? (size_t)num_threads - 1 : 0;
+    ThreadPool* pool = calloc(1, sizeof(ThreadPool));
+    if (!pool) {
+        fprintf(stderr, "Memory allocation failed for thread pool\n");
+        return NULL;
+    }
+    pool->inline_threshold = THREAD_POOL_INLINE_ITEMS;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+    if (wanted == 0) return pool;
+
+    pool->threads = malloc(wanted * sizeof(pthread_t));
+    pool->worker_args = malloc(wanted * sizeof(WorkerArg));
+    pool->queues = calloc(wanted, sizeof(TaskQueue));
+    if (!pool->threads || !pool->worker_args || !pool->queues) {
+        fprintf(stderr, "Memory allocation failed for thread pool\n");
+        thread_pool_destroy(pool);
+        return NULL;
+    }
+    for (size_t i = 0; i < wanted; ++i) {
+        TaskQueue* q = &pool->queues[i];
+        q->tasks = malloc(QUEUE_INITIAL_CAPACITY * sizeof(Task));
+        q->capacity = QUEUE_INITIAL_CAPACITY;
+        pthread_mutex_init(&q->lock, NULL);
+        pool->queue_count++;
+        if (!q->tasks) {
+            fprintf(stderr, "Memory allocation failed for thread pool\n");
+            thread_pool_destroy(pool);
+            return NULL;
+        }
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    for (size_t i = 0; i < wanted; ++i) {
+        pool->worker_args[i].pool = pool;
+        pool->worker_args[i].index = i;
+        if (pthread_create(&pool->threads[i], NULL, worker_main, &pool->worker_args[i]) != 0) break;
+        pool->workers++;
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return pool;
+}
+
+/**
+ * @brief Stops the workers and frees the pool.
+ * @param pool The ThreadPool to destroy (may be NULL). No thread_pool_run call may be in progress.
+ */
+void thread_pool_destroy(ThreadPool* pool) {
+    if (!pool) return;
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->lock);
+    for (size_t i = 0; i < pool->workers; ++i) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    for (size_t i = 0; i < pool->queue_count; ++i) {
+        free(pool->queues[i].tasks);
+        pthread_mutex_destroy(&pool->queues[i].lock);
+    }
+    free(pool->queues);
+    free(pool->worker_args);
+    free(pool->threads);
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_cond_destroy(&pool->work_cond);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+/**
+ * @brief Number of threads that run tasks submitted to the pool.
+ * @param pool The ThreadPool (may be NULL).
+ * @return Workers plus the calling thread; 1 for a NULL pool.
+ */
+size_t thread_pool_size(const ThreadPool* pool) {
+    return pool ? pool->workers + 1 : 1;
+}
+
+/**
+ * @brief Sets the work size below which thread_pool_parallelism asks for a single chunk.
+ * @param pool The ThreadPool (may be NULL).
+ * @param items Minimum number of items worth splitting (0 always splits).
+ */
+void thread_pool_set_inline_threshold(ThreadPool* pool, size_t items) {
+    if (pool) pool->inline_threshold = items;
+}
+
+/**
+ * @brief Number of chunks a routine should split items into.
+ *
+ * Below the inline threshold dispatch costs more than it saves, so the answer is 1 and the
+ * routine runs on the calling thread alone.
+ * @param pool The ThreadPool (may be NULL).
+ * @param items Size of the work (points, candidates, ...).
+ * @return 1 for a NULL pool or small work, otherwise thread_pool_size(pool).
+ */
+size_t thread_pool_parallelism(const ThreadPool* pool, size_t items) {
+    if (!pool || items < pool->inline_threshold) return 1;
+    return thread_pool_size(pool);
+}
+
+/**
+ * @brief Runs count tasks on the pool and waits for all of them.
+ *
+ * Tasks are dealt round-robin over the worker queues. Idle workers steal from the other
+ * queues, and the caller runs queued tasks while it waits, so uneven tasks balance out and
+ * nested calls from inside a task cannot deadlock. Several threads may submit concurrently.
+ * With a NULL pool, no workers or a single task, everything runs inline on the caller.
+ * @param pool The ThreadPool (may be NULL).
+ * @param fn Task body.
+ * @param args Array of count arguments, arg_size bytes apart; task i receives args + i * arg_size.
+ * @param arg_size Size of one argument (0 hands every task args itself).
+ * @param count Number of tasks.
+ */
+void thread_pool_run(ThreadPool* pool, ThreadPoolTask fn, void* args, size_t arg_size, size_t count) {
+    char* base = (char*)args;
+    if (!pool || pool->workers == 0 || count <= 1) {
+        for (size_t i = 0; i < count; ++i) fn(base + i * arg_size);
+        return;
+    }
+
+    TaskGroup group = {count};
+    size_t start = __atomic_fetch_add(&pool->next_queue, count, __ATOMIC_RELAXED);
+    for (size_t i = 0; i < count; ++i) {
+        Task task = {fn, base + i * arg_size, &group};
+        __atomic_add_fetch(&pool->queued, 1, __ATOMIC_ACQ_REL);
+        if (queue_push(&pool->queues[(start + i) % pool->workers], &task) != 0) {
+            __atomic_sub_fetch(&pool->queued, 1, __ATOMIC_ACQ_REL);
+            run_task(pool, &task);  // Queue full and out of memory: run it here
+        }
+    }
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    // Help until this group is done; sleep only when there is nothing left to take
+    while (__atomic_load_n(&group.remaining, __ATOMIC_ACQUIRE) > 0) {
+        Task task;
+        if (take_task(pool, NO_QUEUE, &task)) {
+            run_task(pool, &task);
+            continue;
+        }
+        pthread_mutex_lock(&pool->lock);
+        while (__atomic_load_n(&group.remaining, __ATOMIC_ACQUIRE) > 0 &&
+               __atomic_load_n(&pool->queued, __ATOMIC_ACQUIRE) == 0) {
+            pthread_cond_wait(&pool->done_cond, &pool->lock);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
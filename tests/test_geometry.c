@@ -1,143 +1,1662 @@
-#include "../include/geometry.h"  // Access project headers
-#include <stdio.h>                // For printf in tests
-#include <stdlib.h>               // For malloc/free in tests
-#include <math.h>                 // For fabs in assertions
-#include <string.h>               // For strcmp if needed
-
-#define ASSERT_TRUE(cond) do { \
-    tests_run++; \
-    if (!(cond)) { \
-        printf("FAIL: %s\n", #cond); \
-        tests_failed++; \
-    } \
-} while (0)
-
-#define ASSERT_FLOAT_EQ(expected, actual, epsilon) do { \
-    tests_run++; \
-    if (fabsf((expected) - (actual)) > (epsilon)) { \
-        printf("FAIL: Expected %f, got %f\n", (float)(expected), (float)(actual)); \
-        tests_failed++; \
-    } \
-} while (0)
-
-static int tests_run = 0;
-static int tests_failed = 0;
-
-// Test IO: load and save (using temporary in-memory simulation)
-static void test_io() {
-    // Hardcoded sample data (equivalent to a small CSV)
-    Point sample_points[] = {{0,0,0}, {1,1,0}, {2,0,0}};
-    size_t sample_count = 3;
-
-    // Simulate load (we'll create a set manually)
-    PointSet* set = malloc(sizeof(PointSet));
-    set->points = malloc(sample_count * sizeof(Point));
-    memcpy(set->points, sample_points, sample_count * sizeof(Point));
-    set->count = sample_count;
-    set->is_3d = 0;
-
-    // Test save (to a temp file, but for simplicity, we just call it; in real test, could check file)
-    const char* temp_file = "test_output.csv";
-    int save_result = save_points(set, temp_file);
-    ASSERT_TRUE(save_result == 0);
-
-    // Test load
-    PointSet* loaded = load_points(temp_file);
-    ASSERT_TRUE(loaded != NULL);
-    ASSERT_TRUE(loaded->count == sample_count);
-    ASSERT_TRUE(loaded->is_3d == 0);
-    ASSERT_FLOAT_EQ(set->points[0].x, loaded->points[0].x, 0.001f);
-    ASSERT_FLOAT_EQ(set->points[1].y, loaded->points[1].y, 0.001f);
-
-    // Cleanup
-    free_points(set);
-    free_points(loaded);
-    remove(temp_file);  // Delete temp file
-}
-
-// Test distance
-static void test_distance() {
-    Point a = {0, 0, 0};
-    Point b = {3, 4, 0};
-    ASSERT_FLOAT_EQ(5.0f, compute_distance(&a, &b), 0.001f);
-
-    Point c = {0, 0, 0};
-    Point d = {1, 2, 2};
-    ASSERT_FLOAT_EQ(sqrtf(1+4+4), compute_distance(&c, &d), 0.001f);
-}
-
-// Test collinear
-static void test_collinear() {
-    Point a = {0, 0, 0};
-    Point b = {1, 1, 0};
-    Point c = {2, 2, 0};
-    ASSERT_TRUE(is_collinear(&a, &b, &c) == 1);
-
-    Point d = {0, 0, 0};
-    Point e = {1, 0, 0};
-    Point f = {0, 1, 0};
-    ASSERT_TRUE(is_collinear(&d, &e, &f) == 0);
-}
-
-// Test convex hull (simple triangle)
-static void test_convex_hull_simple() {
-    Point points[] = {{0,0,0}, {1,0,0}, {0,1,0}};
-    PointSet set = {points, 3, 0};
-
-    PointSet* hull = compute_convex_hull(&set, 1);  // Fixed: added num_threads=1
-    ASSERT_TRUE(hull != NULL);
-    ASSERT_TRUE(hull->count == 3);  // Should remain 3 for convex set
-
-    free_points(hull);
-}
-
-// Test convex hull with internal point
-static void test_convex_hull_with_internal() {
-    Point points[] = {{0,0,0}, {4,0,0}, {0,3,0}, {1,1,0}};  // (1,1) is internal
-    PointSet set = {points, 4, 0};
-
-    PointSet* hull = compute_convex_hull(&set, 1);  // Fixed: added num_threads=1
-    ASSERT_TRUE(hull != NULL);
-    ASSERT_TRUE(hull->count == 3);  // Should simplify to triangle
-
-    free_points(hull);
-}
-
-// Test convex hull edge case: <3 points
-static void test_convex_hull_edge() {
-    Point points[] = {{0,0,0}, {1,0,0}};
-    PointSet set = {points, 2, 0};
-
-    PointSet* hull = compute_convex_hull(&set, 1);  // Fixed: added num_threads=1
-    ASSERT_TRUE(hull == NULL);  // Should fail
-}
-
-// Test area
-static void test_area() {
-    Point points[] = {{0,0,0}, {3,0,0}, {0,4,0}};
-    PointSet hull = {points, 3, 0};
-    ASSERT_FLOAT_EQ(6.0f, compute_area(&hull), 0.001f);  // (3*4)/2 = 6
-}
-
-// Test path length (perimeter)
-static void test_path_length() {
-    Point points[] = {{0,0,0}, {3,0,0}, {0,4,0}};
-    PointSet hull = {points, 3, 0};
-    float expected = 3 + 5 + 4;  // Sides: 3, sqrt(9+16)=5, 4
-    ASSERT_FLOAT_EQ(expected, compute_path_length(&hull), 0.001f);
-}
-
-// Run all tests
-void run_all_tests() {
-    test_io();
-    test_distance();
-    test_collinear();
-    test_convex_hull_simple();
-    test_convex_hull_with_internal();
-    test_convex_hull_edge();
-    test_area();
-    test_path_length();
-}
-
-int get_tests_run() { return tests_run; }
+#include "../include/geometry.h"  // Access project headers
+#include "../include/pointset_soa.h"
+#include "../include/simd.h"
+#include "../include/predicates.h"
+#include "../include/thread_pool.h"
+#include "../include/bench.h"
+#include "../include/stats.h"
+#include "../include/arena.h"
+#include "../include/quantize.h"
+#include <stdio.h>                // For printf in tests
+#include <stdlib.h>               // For malloc/free in tests
+#include <math.h>                 // For fabs in assertions
+#include <string.h>               // For strcmp if needed
+#include <pthread.h>              // For concurrent hull test
+
+#define ASSERT_TRUE(cond) do { \
+    tests_run++; \
+    if (!(cond)) { \
+        printf("FAIL: %s\n", #cond); \
+        tests_failed++; \
+    } \
+} while (0)
+
+#define ASSERT_FLOAT_EQ(expected, actual, epsilon) do { \
+    tests_run++; \
+    if (fabsf((expected) - (actual)) > (epsilon)) { \
+        printf("FAIL: Expected %f, got %f\n", (float)(expected), (float)(actual)); \
+        tests_failed++; \
+    } \
+} while (0)
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#ifdef __GLIBC__
+// Counts heap calls made anywhere in the process while watching, so a malloc that bypasses
+// the arena (and so STATS_ALLOCATIONS) still fails the steady-state tests
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void* __libc_memalign(size_t alignment, size_t size);
+static int heap_watching = 0;
+static uint64_t heap_calls = 0;
+
+static void count_heap_call(void) {
+    if (__atomic_load_n(&heap_watching, __ATOMIC_RELAXED)) __atomic_fetch_add(&heap_calls, 1, __ATOMIC_RELAXED);
+}
+
+void* malloc(size_t size) { count_heap_call(); return __libc_malloc(size); }
+void* calloc(size_t count, size_t size) { count_heap_call(); return __libc_calloc(count, size); }
+void* realloc(void* ptr, size_t size) { count_heap_call(); return __libc_realloc(ptr, size); }
+int posix_memalign(void** ptr, size_t alignment, size_t size) {
+    count_heap_call();
+    *ptr = __libc_memalign(alignment, size);
+    return *ptr ? 0 : 12;  // ENOMEM
+}
+
+static void heap_watch(int on) { __atomic_store_n(&heap_watching, on, __ATOMIC_RELAXED); }
+static uint64_t heap_calls_seen(void) { return __atomic_load_n(&heap_calls, __ATOMIC_RELAXED); }
+#else
+static void heap_watch(int on) { (void)on; }
+static uint64_t heap_calls_seen(void) { return 0; }
+#endif
+
+// Test IO: load and save (using temporary in-memory simulation)
+static void test_io() {
+    // Hardcoded sample data (equivalent to a small CSV)
+    Point sample_points[] = {{0,0,0}, {1,1,0}, {2,0,0}};
+    size_t sample_count = 3;
+
+    // Simulate load (we'll create a set manually)
+    PointSet* set = malloc(sizeof(PointSet));
+    set->points = malloc(sample_count * sizeof(Point));
+    memcpy(set->points, sample_points, sample_count * sizeof(Point));
+    set->count = sample_count;
+    set->is_3d = 0;
+
+    // Test save (to a temp file, but for simplicity, we just call it; in real test, could check file)
+    const char* temp_file = "test_output.csv";
+    int save_result = save_points(set, temp_file, 2);
+    ASSERT_TRUE(save_result == 0);
+
+    // Test load
+    PointSet* loaded = load_points(temp_file);
+    ASSERT_TRUE(loaded != NULL);
+    ASSERT_TRUE(loaded->count == sample_count);
+    ASSERT_TRUE(loaded->is_3d == 0);
+    ASSERT_FLOAT_EQ(set->points[0].x, loaded->points[0].x, 0.001f);
+    ASSERT_FLOAT_EQ(set->points[1].y, loaded->points[1].y, 0.001f);
+
+    // Cleanup
+    free_points(set);
+    free_points(loaded);
+    remove(temp_file);  // Delete temp file
+}
+
+// Test mmap loader: same field rules as load_points, no line length limit
+static void test_load_mmap() {
+    const char* temp_file = "test_mmap.csv";
+    FILE* f = fopen(temp_file, "w");
+    ASSERT_TRUE(f != NULL);
+    if (!f) return;
+    fprintf(f, "x,y,z\n");              // Header: skipped
+    fprintf(f, "1.5,-2.25\r\n");        // CRLF line
+    fprintf(f, " 3e2, 4.0E-1 ,0\n");    // Exponents and spaces before numbers
+    fprintf(f, "\n");                   // Blank: skipped
+    fprintf(f, "7\n");                  // One field: skipped
+    fprintf(f, "500000.125,4000000.5,12.75\n");
+    fprintf(f, "0.5,0.25,0.");          // Long line (truncated by the stdio loader)
+    for (int i = 0; i < 300; ++i) fputc('0', f);
+    fprintf(f, "1\n");
+    fprintf(f, "161.48941802978516,3843.6610107421875\n");  // Exact float halfway cases
+    fprintf(f, "-.5,+.5");              // No trailing newline
+    fclose(f);
+
+    PointSet* set = load_points_mmap(temp_file, NULL);
+    ASSERT_TRUE(set != NULL);
+    if (set) {
+        ASSERT_TRUE(set->count == 6);
+        ASSERT_TRUE(set->is_3d == 1);
+        if (set->count == 6) {
+            ASSERT_FLOAT_EQ(1.5f, set->points[0].x, 0.0f);
+            ASSERT_FLOAT_EQ(-2.25f, set->points[0].y, 0.0f);
+            ASSERT_FLOAT_EQ(300.0f, set->points[1].x, 0.0f);
+            ASSERT_FLOAT_EQ(0.4f, set->points[1].y, 0.0f);
+            ASSERT_FLOAT_EQ(500000.125f, set->points[2].x, 0.0f);
+            ASSERT_FLOAT_EQ(4000000.5f, set->points[2].y, 0.0f);
+            ASSERT_FLOAT_EQ(12.75f, set->points[2].z, 0.0f);
+            ASSERT_FLOAT_EQ(0.0f, set->points[3].z, 0.0f);  // 1e-301 underflows to zero
+            ASSERT_FLOAT_EQ(strtof("161.48941802978516", NULL), set->points[4].x, 0.0f);
+            ASSERT_FLOAT_EQ(strtof("3843.6610107421875", NULL), set->points[4].y, 0.0f);
+            ASSERT_FLOAT_EQ(-0.5f, set->points[5].x, 0.0f);
+            ASSERT_FLOAT_EQ(0.5f, set->points[5].y, 0.0f);
+        }
+    }
+    free_points(set);
+    remove(temp_file);
+}
+
+// Test the mmap parser agrees with the stdio loader on hex floats, which start with a digit
+static void test_load_mmap_hex() {
+    const char* temp_file = "test_mmap_hex.csv";
+    FILE* f = fopen(temp_file, "w");
+    ASSERT_TRUE(f != NULL);
+    if (!f) return;
+    fprintf(f, "0x10,5\n");
+    fprintf(f, "-0X1.8p1, 0x0\n");
+    fprintf(f, "+0x.8,1e1\n");
+    fprintf(f, "0,0\n5,10\n10,0\n");
+    fclose(f);
+
+    PointSet* stdio_set = load_points(temp_file);
+    PointSet* mmap_set = load_points_mmap(temp_file, NULL);
+    ASSERT_TRUE(stdio_set != NULL && mmap_set != NULL);
+    if (stdio_set && mmap_set) {
+        ASSERT_TRUE(stdio_set->count == 6 && mmap_set->count == 6);
+        ASSERT_TRUE(stdio_set->count == mmap_set->count &&
+                    memcmp(stdio_set->points, mmap_set->points, mmap_set->count * sizeof(Point)) == 0);
+        if (mmap_set->count == 6) {
+            ASSERT_FLOAT_EQ(16.0f, mmap_set->points[0].x, 0.0f);
+            ASSERT_FLOAT_EQ(-3.0f, mmap_set->points[1].x, 0.0f);
+            ASSERT_FLOAT_EQ(0.5f, mmap_set->points[2].x, 0.0f);
+        }
+    }
+    free_points(stdio_set);
+    free_points(mmap_set);
+    remove(temp_file);
+}
+
+// Test parallel mmap parsing: ranges concatenate in file order, is_3d combined across workers
+static void test_load_mmap_threads() {
+    const char* temp_file = "test_mmap_threads.csv";
+    FILE* f = fopen(temp_file, "w");
+    ASSERT_TRUE(f != NULL);
+    if (!f) return;
+    size_t n = 200000;  // ~2.5 MB: enough for several parser ranges
+    for (size_t i = 0; i < n; ++i) {
+        if (i == n - 10) {
+            fprintf(f, "%zu.5,%zu.25,3.5\n", i, i);  // Only the last range sees a z
+        } else {
+            fprintf(f, "%zu.5,%zu.25\n", i, i);
+        }
+    }
+    fclose(f);
+
+    ThreadPool* pool = thread_pool_create(7);
+    PointSet* serial = load_points_mmap(temp_file, NULL);
+    PointSet* parallel = load_points_mmap(temp_file, pool);
+    ASSERT_TRUE(serial != NULL && parallel != NULL);
+    if (serial && parallel) {
+        ASSERT_TRUE(parallel->count == n);
+        ASSERT_TRUE(parallel->is_3d == 1);
+        ASSERT_TRUE(serial->count == parallel->count);
+        ASSERT_TRUE(memcmp(serial->points, parallel->points, n * sizeof(Point)) == 0);
+    }
+
+    // Pooled ranges appended into reused storage
+    PointSet reused = {NULL, 0, 0};
+    size_t capacity = 0;
+    ASSERT_TRUE(load_points_into(temp_file, &reused, &capacity, pool) == 0);
+    ASSERT_TRUE(reused.count == n && reused.is_3d == 1 && capacity >= n);
+    if (serial && reused.count == n) {
+        ASSERT_TRUE(memcmp(serial->points, reused.points, n * sizeof(Point)) == 0);
+    }
+    free(reused.points);
+    free_points(serial);
+    free_points(parallel);
+    thread_pool_destroy(pool);
+    remove(temp_file);
+}
+
+// Test buffer reuse: a smaller file keeps the storage, a larger one grows it, a missing one fails
+static void test_load_points_into() {
+    const char* small_file = "test_into_small.csv";
+    const char* large_file = "test_into_large.csv";
+    FILE* f = fopen(small_file, "w");
+    ASSERT_TRUE(f != NULL);
+    if (!f) return;
+    fprintf(f, "1,2,3\n4,5,6\n");
+    fclose(f);
+    f = fopen(large_file, "w");
+    ASSERT_TRUE(f != NULL);
+    if (!f) return;
+    for (int i = 0; i < 5000; ++i) fprintf(f, "%d.5,%d\n", i, -i);
+    fclose(f);
+
+    PointSet set = {NULL, 0, 0};
+    size_t capacity = 0;
+    ASSERT_TRUE(load_points_into(large_file, &set, &capacity, NULL) == 0);
+    ASSERT_TRUE(set.count == 5000 && set.is_3d == 0 && capacity >= 5000);
+    if (set.count == 5000) ASSERT_FLOAT_EQ(4999.5f, set.points[4999].x, 0.0f);
+
+    Point* storage = set.points;
+    size_t grown = capacity;
+    ASSERT_TRUE(load_points_into(small_file, &set, &capacity, NULL) == 0);
+    ASSERT_TRUE(set.count == 2 && set.is_3d == 1);
+    ASSERT_TRUE(set.points == storage && capacity == grown);  // No reallocation
+    if (set.count == 2) ASSERT_FLOAT_EQ(6.0f, set.points[1].z, 0.0f);
+
+    ASSERT_TRUE(load_points_into("missing_into.csv", &set, &capacity, NULL) == -1);
+    ASSERT_TRUE(set.points == storage);  // Storage survives a failed load
+    free(set.points);
+    remove(small_file);
+    remove(large_file);
+}
+
+// Helper: Reads a whole file into a NUL-terminated buffer
+static char* read_file(const char* filename) {
+    FILE* f = fopen(filename, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* data = malloc((size_t)size + 1);
+    if (data && fread(data, 1, (size_t)size, f) != (size_t)size) {
+        free(data);
+        data = NULL;
+    }
+    if (data) data[size] = '\0';
+    fclose(f);
+    return data;
+}
+
+// Test fast formatter: byte-identical to fprintf("%.*f") across tricky values and precisions
+static void test_save_format() {
+    const char* temp_file = "test_format.csv";
+    size_t n = 2000;
+    Point* points = malloc(n * sizeof(Point));
+    float specials[] = {0.0f, -0.0f, 0.125f, 0.375f, -0.001f, 2.5f, 1e-30f, 123456.789f,
+                        2147483520.0f, 3.0e9f, -1.0e20f, 0.005f, 1.005f, 999.995f};
+    size_t num_specials = sizeof(specials) / sizeof(specials[0]);
+    srand(3);
+    for (size_t i = 0; i < n; ++i) {
+        points[i].x = i < num_specials ? specials[i] : ((float)rand() / RAND_MAX - 0.5f) * 2e6f;
+        points[i].y = (float)rand() / RAND_MAX * 10.0f;
+        points[i].z = (float)(rand() % 1000) / 8.0f;  // Exact ties at 1/8 steps
+    }
+    PointSet set = {points, n, 1};
+
+    int precisions[] = {0, 2, 5};
+    for (size_t k = 0; k < 3; ++k) {
+        int precision = precisions[k];
+        ASSERT_TRUE(save_points(&set, temp_file, precision) == 0);
+        size_t cap = n * 3 * 64;
+        char* expected = malloc(cap);
+        size_t len = 0;
+        for (size_t i = 0; i < n; ++i) {
+            len += (size_t)snprintf(expected + len, cap - len, "%.*f,%.*f,%.*f\n",
+                                    precision, points[i].x, precision, points[i].y, precision, points[i].z);
+        }
+        char* actual = read_file(temp_file);
+        ASSERT_TRUE(actual != NULL && strcmp(expected, actual) == 0);
+        free(actual);
+        free(expected);
+    }
+
+    free(points);
+    remove(temp_file);
+}
+
+// Test binary format round trip for 2D and 3D sets, through both loaders
+static void test_binary_roundtrip() {
+    const char* temp_file = "test_points.igcb";
+    Point points[] = {{1.5f, -2.25f, 0.0f}, {500000.125f, 4000000.5f, 12.75f}, {-0.0f, 1e-30f, 3.0f}};
+    for (int is_3d = 0; is_3d <= 1; ++is_3d) {
+        PointSet set = {points, 3, is_3d};
+        ASSERT_TRUE(save_points(&set, temp_file, 2) == 0);
+
+        PointSet* a = load_points(temp_file);
+        PointSet* b = load_points_mmap(temp_file, NULL);
+        ASSERT_TRUE(a != NULL && b != NULL);
+        if (a && b) {
+            ASSERT_TRUE(a->count == 3 && b->count == 3);
+            ASSERT_TRUE(a->is_3d == is_3d && b->is_3d == is_3d);
+            for (size_t i = 0; i < 3 && i < a->count; ++i) {
+                ASSERT_TRUE(a->points[i].x == points[i].x && a->points[i].y == points[i].y);
+                ASSERT_TRUE(a->points[i].z == (is_3d ? points[i].z : 0.0f));
+            }
+            ASSERT_TRUE(memcmp(a->points, b->points, 3 * sizeof(Point)) == 0);
+        }
+        free_points(a);
+        free_points(b);
+    }
+
+    // Truncated payload is rejected
+    FILE* f = fopen(temp_file, "r+b");
+    if (f) {
+        unsigned char count_bytes[8] = {0xFF, 0xFF, 0, 0, 0, 0, 0, 0};
+        fseek(f, 8, SEEK_SET);
+        fwrite(count_bytes, 1, sizeof(count_bytes), f);
+        fclose(f);
+    }
+    ASSERT_TRUE(load_points(temp_file) == NULL);
+    remove(temp_file);
+}
+
+// Test distance
+static void test_distance() {
+    Point a = {0, 0, 0};
+    Point b = {3, 4, 0};
+    ASSERT_FLOAT_EQ(5.0f, compute_distance(&a, &b), 0.001f);
+
+    Point c = {0, 0, 0};
+    Point d = {1, 2, 2};
+    ASSERT_FLOAT_EQ(sqrtf(1+4+4), compute_distance(&c, &d), 0.001f);
+}
+
+// Test collinear
+static void test_collinear() {
+    Point a = {0, 0, 0};
+    Point b = {1, 1, 0};
+    Point c = {2, 2, 0};
+    ASSERT_TRUE(is_collinear(&a, &b, &c) == 1);
+
+    Point d = {0, 0, 0};
+    Point e = {1, 0, 0};
+    Point f = {0, 1, 0};
+    ASSERT_TRUE(is_collinear(&d, &e, &f) == 0);
+}
+
+// Test orient2d signs against exact integer arithmetic on a 1/32 grid at survey coordinates
+static void test_orient2d() {
+    // Points on y = 3x whose differences do not fit in a double: the plain double formula
+    // returns 0 for all three, only the adaptive stages see the one-ulp nudges of c.y
+    Point a = {0x1p30f, 0x3p30f, 0};
+    Point b = {1, 3, 0};
+    Point c = {0x3p-55f, 0x9p-55f, 0};
+    unsigned long exact_before = orient2d_exact_calls();
+    ASSERT_TRUE(orient2d(&a, &b, &c) == 0.0);
+    ASSERT_TRUE(is_collinear(&a, &b, &c) == 1);
+    c.y = 0x9p-55f + 0x1p-75f;
+    ASSERT_TRUE(orient2d_fast(&a, &b, &c) == 0.0);
+    ASSERT_TRUE(orient2d(&a, &b, &c) < 0);  // Exact value is 2^-75 * (1 - 2^30)
+    ASSERT_TRUE(is_collinear(&a, &b, &c) == 0);
+    c.y = 0x9p-55f - 0x1p-75f;
+    ASSERT_TRUE(orient2d(&a, &b, &c) > 0);
+    ASSERT_TRUE(orient2d_exact_calls() > exact_before);
+
+    size_t wrong = 0;
+    srand(29);
+    for (int t = 0; t < 20000; ++t) {
+        // Points on a line through two grid points, then nudged by 0 or +-1 grid step
+        long long ax = 16000000 + rand() % 1000, ay = 16000000 + rand() % 1000;
+        long long dx = rand() % 2000 - 1000, dy = rand() % 2000 - 1000;
+        long long k = rand() % 64 + 1;
+        long long bx = ax + dx, by = ay + dy;
+        long long cx = ax + k * dx, cy = ay + k * dy + (rand() % 3 - 1);
+        Point pa = {ax / 32.0f, ay / 32.0f, 0}, pb = {bx / 32.0f, by / 32.0f, 0}, pc = {cx / 32.0f, cy / 32.0f, 0};
+        long long exact = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+        double orient = orient2d(&pa, &pb, &pc);
+        int sign = (orient > 0) - (orient < 0);
+        wrong += sign != (exact > 0) - (exact < 0);
+    }
+    ASSERT_TRUE(wrong == 0);
+}
+
+// Test Graham and monotone chain agree on large coordinates with many collinear ties
+static void test_convex_hull_large_coordinates() {
+    size_t n = 20000;
+    Point* points = malloc(n * sizeof(Point));
+    srand(31);
+    for (size_t i = 0; i < n; ++i) {
+        points[i].x = 500000.0f + (float)(rand() % 3200) / 32.0f;  // Exact 1/32 grid near UTM eastings
+        points[i].y = 5000000.0f + (float)(rand() % 400) / 4.0f;
+        points[i].z = 0.0f;
+    }
+    points[7] = points[3];  // Duplicates of arbitrary points
+    PointSet set = {points, n, 0};
+
+    PointSet* graham = compute_convex_hull(&set, NULL, NULL);
+    PointSet* monotone = compute_convex_hull_monotone(&set, NULL, NULL);
+    ASSERT_TRUE(graham != NULL && monotone != NULL);
+    if (graham && monotone) {
+        ASSERT_TRUE(graham->count == monotone->count);
+        size_t missing = 0;
+        for (size_t i = 0; i < graham->count; ++i) {
+            int found = 0;
+            for (size_t j = 0; j < monotone->count; ++j) {
+                found |= graham->points[i].x == monotone->points[j].x && graham->points[i].y == monotone->points[j].y;
+            }
+            missing += !found;
+        }
+        ASSERT_TRUE(missing == 0);
+        // Strictly convex: no three consecutive vertices collinear
+        size_t flat = 0;
+        for (size_t i = 0; i < graham->count; ++i) {
+            flat += orient2d(&graham->points[i], &graham->points[(i + 1) % graham->count],
+                             &graham->points[(i + 2) % graham->count]) <= 0;
+        }
+        ASSERT_TRUE(flat == 0);
+    }
+    free_points(graham);
+    free_points(monotone);
+    free(points);
+}
+
+// Test convex hull (simple triangle)
+static void test_convex_hull_simple() {
+    Point points[] = {{0,0,0}, {1,0,0}, {0,1,0}};
+    PointSet set = {points, 3, 0};
+
+    PointSet* hull = compute_convex_hull(&set, NULL, NULL);
+    ASSERT_TRUE(hull != NULL);
+    ASSERT_TRUE(hull->count == 3);  // Should remain 3 for convex set
+
+    free_points(hull);
+}
+
+// Test convex hull with internal point
+static void test_convex_hull_with_internal() {
+    Point points[] = {{0,0,0}, {4,0,0}, {0,3,0}, {1,1,0}};  // (1,1) is internal
+    PointSet set = {points, 4, 0};
+
+    PointSet* hull = compute_convex_hull(&set, NULL, NULL);
+    ASSERT_TRUE(hull != NULL);
+    ASSERT_TRUE(hull->count == 3);  // Should simplify to triangle
+
+    free_points(hull);
+}
+
+// Test convex hull edge case: <3 points
+static void test_convex_hull_edge() {
+    Point points[] = {{0,0,0}, {1,0,0}};
+    PointSet set = {points, 2, 0};
+
+    PointSet* hull = compute_convex_hull(&set, NULL, NULL);
+    ASSERT_TRUE(hull == NULL);  // Should fail
+}
+
+// Test multithreaded hull matches the single-threaded result (parallel sort + merge)
+static void test_convex_hull_threads() {
+    size_t n = 5000;
+    Point* points = malloc(n * sizeof(Point));
+    srand(42);
+    for (size_t i = 0; i < n; ++i) {
+        points[i].x = (float)(rand() % 1000);  // Integer grid: many collinear ties
+        points[i].y = (float)(rand() % 1000);
+        points[i].z = 0.0f;
+    }
+    PointSet set = {points, n, 0};
+
+    ThreadPool* pool = thread_pool_create(5);
+    PointSet* serial = compute_convex_hull(&set, NULL, NULL);
+    PointSet* parallel = compute_convex_hull(&set, pool, NULL);
+    ASSERT_TRUE(serial != NULL && parallel != NULL);
+    if (serial && parallel) {
+        ASSERT_TRUE(serial->count == parallel->count);
+        ASSERT_TRUE(memcmp(serial->points, parallel->points, serial->count * sizeof(Point)) == 0);
+    }
+
+    free_points(serial);
+    free_points(parallel);
+    thread_pool_destroy(pool);
+    free(points);
+}
+
+typedef struct {
+    ThreadPool* pool;
+    size_t index;
+    size_t runs;  // Times this task ran
+    size_t sum;   // Filled by nested tasks
+} PoolTask;
+
+// Helper: Uneven busy work so some queues drain long before others
+static void pool_leaf(void* arg) {
+    PoolTask* t = (PoolTask*)arg;
+    volatile size_t spin = 0;
+    for (size_t k = 0; k < (t->index % 16) * 2000; ++k) spin += k;
+    t->runs++;
+}
+
+// Helper: Submits inner tasks from inside a task and sums their indices
+static void pool_nested(void* arg) {
+    PoolTask* t = (PoolTask*)arg;
+    PoolTask inner[8];
+    for (size_t k = 0; k < 8; ++k) inner[k] = (PoolTask){NULL, t->index * 8 + k, 0, 0};
+    thread_pool_run(t->pool, pool_leaf, inner, sizeof(PoolTask), 8);
+    for (size_t k = 0; k < 8; ++k) t->sum += inner[k].index * inner[k].runs;
+    t->runs++;
+}
+
+// Test thread pool: every task runs exactly once, nested runs finish, small work stays inline
+static void test_thread_pool() {
+    ASSERT_TRUE(thread_pool_size(NULL) == 1);
+    ASSERT_TRUE(thread_pool_parallelism(NULL, 1 << 20) == 1);
+
+    ThreadPool* pool = thread_pool_create(4);
+    ASSERT_TRUE(pool != NULL);
+    if (!pool) return;
+    ASSERT_TRUE(thread_pool_size(pool) == 4);
+    ASSERT_TRUE(thread_pool_parallelism(pool, 100) == 1);  // Below THREAD_POOL_INLINE_ITEMS
+    ASSERT_TRUE(thread_pool_parallelism(pool, 1 << 20) == 4);
+
+    enum { TASKS = 1000, OUTER = 32 };
+    PoolTask* tasks = malloc(TASKS * sizeof(PoolTask));
+    for (size_t i = 0; i < TASKS; ++i) tasks[i] = (PoolTask){NULL, i, 0, 0};
+    thread_pool_run(pool, pool_leaf, tasks, sizeof(PoolTask), TASKS);  // Outgrows the initial queues
+    size_t wrong = 0;
+    for (size_t i = 0; i < TASKS; ++i) wrong += tasks[i].runs != 1;
+    ASSERT_TRUE(wrong == 0);
+
+    PoolTask outer[OUTER];
+    for (size_t i = 0; i < OUTER; ++i) outer[i] = (PoolTask){pool, i, 0, 0};
+    thread_pool_run(pool, pool_nested, outer, sizeof(PoolTask), OUTER);
+    wrong = 0;
+    for (size_t i = 0; i < OUTER; ++i) wrong += outer[i].runs != 1 || outer[i].sum != 64 * i + 28;
+    ASSERT_TRUE(wrong == 0);
+
+    free(tasks);
+    thread_pool_destroy(pool);
+}
+
+// Test benchmark statistics: nearest-rank p95, even-count median, input order irrelevant
+static void test_bench_summary() {
+    double samples[20];
+    for (int i = 0; i < 20; ++i) samples[i] = (double)((i * 7) % 20 + 1);  // 1..20 shuffled
+    BenchSummary summary;
+    bench_summarize(samples, 20, &summary);
+    ASSERT_FLOAT_EQ(1.0f, (float)summary.min, 0.0f);
+    ASSERT_FLOAT_EQ(10.5f, (float)summary.median, 0.0f);
+    ASSERT_FLOAT_EQ(19.0f, (float)summary.p95, 0.0f);
+    ASSERT_FLOAT_EQ(10.5f, (float)summary.mean, 0.0f);
+
+    double single = 4.25;
+    bench_summarize(&single, 1, &summary);
+    ASSERT_TRUE(summary.min == 4.25 && summary.median == 4.25 && summary.p95 == 4.25);
+
+    BenchConfig config;
+    bench_default_config(&config);
+    ASSERT_TRUE(bench_parse_sizes("1000,1e6", &config) == 0);
+    ASSERT_TRUE(config.size_count == 2 && config.sizes[1] == 1000000);
+    ASSERT_TRUE(bench_parse_sizes("1000,", &config) == 0 && config.size_count == 1);
+    ASSERT_TRUE(bench_parse_sizes("10x", &config) == -1);
+    unsigned mask = 0;
+    ASSERT_TRUE(bench_parse_distributions("circle,hull", &mask) == 0);
+    ASSERT_TRUE(mask == ((1u << BENCH_CIRCLE) | (1u << BENCH_ON_HULL)));
+    ASSERT_TRUE(bench_parse_distributions("square", &mask) == -1);
+}
+
+// Test benchmark generators: deterministic per seed, and the hull distribution lies on its hull
+static void test_bench_distributions() {
+    size_t n = 500;
+    size_t bad = 0;
+    for (int d = 0; d < BENCH_DIST_COUNT; ++d) {
+        PointSet* a = bench_generate_points((BenchDistribution)d, n, 0, 9);
+        PointSet* b = bench_generate_points((BenchDistribution)d, n, 0, 9);
+        PointSet* c = bench_generate_points((BenchDistribution)d, n, 0, 10);
+        if (!a || !b || !c || memcmp(a->points, b->points, n * sizeof(Point)) != 0 ||
+            memcmp(a->points, c->points, n * sizeof(Point)) == 0) {
+            bad++;
+        }
+        free_points(a);
+        free_points(b);
+        free_points(c);
+    }
+    ASSERT_TRUE(bad == 0);
+
+    PointSet* ring = bench_generate_points(BENCH_ON_HULL, 200, 0, 3);  // Sparse enough to stay strictly convex
+    PointSet* hull = ring ? compute_convex_hull_monotone(ring, NULL, NULL) : NULL;
+    ASSERT_TRUE(hull != NULL && hull->count == 200);
+    free_points(hull);
+    free_points(ring);
+
+    // Sort and scan phases are recorded only while stats are enabled
+    PointSet* uniform = bench_generate_points(BENCH_UNIFORM, 5000, 0, 1);
+    stats_reset();
+    PointSet* quiet = compute_convex_hull(uniform, NULL, NULL);
+    ASSERT_TRUE(stats_phase_ms(STATS_PHASE_SORT) == 0.0);
+    stats_enable(1);
+    PointSet* timed = compute_convex_hull(uniform, NULL, NULL);
+    stats_enable(0);
+    ASSERT_TRUE(stats_phase_ms(STATS_PHASE_SORT) > 0.0 && stats_phase_ms(STATS_PHASE_SCAN) > 0.0);
+    stats_reset();
+
+    // The partition hull times its fan-out once, so the phases never add up past the wall clock
+    ThreadPool* pool = thread_pool_create(4);
+    thread_pool_set_inline_threshold(pool, 0);
+    stats_enable(1);
+    double wall_start = stats_now_ms();
+    PointSet* partitioned = compute_convex_hull_parallel(uniform, pool, NULL);
+    double wall_ms = stats_now_ms() - wall_start;
+    stats_enable(0);
+    ASSERT_TRUE(partitioned != NULL);
+    ASSERT_TRUE(stats_phase_ms(STATS_PHASE_SORT) > 0.0 && stats_phase_ms(STATS_PHASE_SCAN) > 0.0);
+    ASSERT_TRUE(stats_phase_ms(STATS_PHASE_SORT) + stats_phase_ms(STATS_PHASE_SCAN) <= wall_ms);
+    stats_reset();
+    thread_pool_destroy(pool);
+    free_points(partitioned);
+    free_points(quiet);
+    free_points(timed);
+    free_points(uniform);
+}
+
+// Test stats counters: loader, cull, scan and writer counts, and the JSON report
+static void test_stats_counters() {
+    const char* temp_file = "test_stats.csv";
+    const char* out_file = "test_stats_out.csv";
+    const char* json_file = "test_stats.json";
+    FILE* f = fopen(temp_file, "w");
+    ASSERT_TRUE(f != NULL);
+    if (!f) return;
+    fprintf(f, "x,y\n0,0\n4,0\n\n4,4\n7\n0,4\n2,2\n");  // Header, blank and one-field lines skipped
+    fclose(f);
+
+    stats_reset();
+    stats_enable(1);
+    PointSet* set = load_points_mmap(temp_file, NULL);
+    ASSERT_TRUE(stats_counter(STATS_POINTS_PARSED) == 5 && stats_counter(STATS_LINES_SKIPPED) == 3);
+    PointSet* again = load_points(temp_file);  // stdio parser counts the same way
+    ASSERT_TRUE(stats_counter(STATS_POINTS_PARSED) == 10 && stats_counter(STATS_LINES_SKIPPED) == 6);
+    free_points(again);
+    ASSERT_TRUE(set != NULL);
+    if (!set) {
+        stats_enable(0);
+        remove(temp_file);
+        return;
+    }
+
+    PointSet* survivors = cull_interior_points(set, NULL);
+    ASSERT_TRUE(survivors != NULL && stats_counter(STATS_POINTS_CULLED) == set->count - survivors->count);
+    free_points(survivors);
+
+    // Graham pushes every point once, so the pops are exactly the points not on the hull
+    PointSet* uniform = bench_generate_points(BENCH_UNIFORM, 2000, 0, 5);
+    PointSet* hull = uniform ? compute_convex_hull(uniform, NULL, NULL) : NULL;
+    ASSERT_TRUE(hull != NULL && stats_counter(STATS_HULL_POPS) == uniform->count - hull->count);
+    ASSERT_TRUE(stats_counter(STATS_COMPARISONS) > 0);
+
+    ASSERT_TRUE(save_points(set, out_file, 2) == 0);
+    char* written = read_file(out_file);
+    ASSERT_TRUE(written != NULL && stats_counter(STATS_BYTES_WRITTEN) == strlen(written));
+    free(written);
+
+    FILE* json = fopen(json_file, "w");
+    ASSERT_TRUE(json != NULL);
+    if (json) {
+        stats_write_json(json, 1.5);
+        fclose(json);
+        char* report = read_file(json_file);
+        ASSERT_TRUE(report != NULL && strstr(report, "{\"phases_ms\": {\"load\": ") == report &&
+                    strstr(report, "\"total_ms\": 1.500") != NULL &&
+                    strstr(report, "\"points_parsed\": 10, \"lines_skipped\": 6") != NULL);
+        free(report);
+    }
+
+    // Counters stay put while disabled
+    stats_enable(0);
+    PointSet* quiet = load_points_mmap(temp_file, NULL);
+    ASSERT_TRUE(stats_counter(STATS_POINTS_PARSED) == 10);
+    stats_reset();
+    ASSERT_TRUE(stats_counter(STATS_POINTS_PARSED) == 0 && stats_counter(STATS_BYTES_WRITTEN) == 0);
+
+    free_points(quiet);
+    free_points(hull);
+    free_points(uniform);
+    free_points(set);
+    remove(temp_file);
+    remove(out_file);
+    remove(json_file);
+}
+
+// Test arena: alignment, in-place growth of the last allocation, and block merging on reset
+static void test_arena() {
+    Arena* arena = arena_create(256);
+    ASSERT_TRUE(arena != NULL);
+    if (!arena) return;
+    char* a = arena_alloc(arena, 10);
+    char* b = arena_alloc(arena, 100);
+    ASSERT_TRUE(a && b && (size_t)a % ARENA_ALIGN == 0 && (size_t)b % ARENA_ALIGN == 0);
+    ASSERT_TRUE(arena_used(arena) == 192);
+    ASSERT_TRUE(arena_resize(arena, b, 100, 150) == b && arena_used(arena) == 256);  // Last allocation: in place
+    memcpy(a, "arena", 6);
+    char* moved = arena_resize(arena, a, 10, 20);  // Not the last: copied (into a second block)
+    ASSERT_TRUE(moved != a && moved != NULL && strcmp(moved, "arena") == 0 && arena_capacity(arena) > 256);
+    arena_free(arena, moved);  // Last allocation: rolled back
+    ASSERT_TRUE(arena_used(arena) == 256);
+
+    char* big = arena_alloc(arena, 1000);  // Chains a third block
+    ASSERT_TRUE(big != NULL);
+    size_t capacity = arena_capacity(arena);
+    arena_reset(arena);
+    ASSERT_TRUE(arena_used(arena) == 0 && arena_capacity(arena) == capacity);
+
+    // After the merge the same cycle fits in one block
+    stats_reset();
+    stats_enable(1);
+    arena_alloc(arena, 10);
+    arena_alloc(arena, 150);
+    arena_alloc(arena, 20);
+    arena_alloc(arena, 1000);
+    stats_enable(0);
+    ASSERT_TRUE(stats_counter(STATS_ALLOCATIONS) == 0);
+    arena_destroy(arena);
+    stats_reset();
+}
+
+// Test arena-backed hulls and loading: same results as the heap, no allocations once warmed up
+static void test_arena_steady_state() {
+    const char* temp_file = "test_arena.csv";
+    PointSet* uniform = bench_generate_points(BENCH_UNIFORM, 20000, 0, 7);
+    ASSERT_TRUE(uniform != NULL);
+    if (!uniform) return;
+    ASSERT_TRUE(save_points(uniform, temp_file, 3) == 0);
+    PointSet* loaded_heap = load_points_arena(temp_file, NULL);
+    PointSet* culled_heap = loaded_heap ? cull_interior_points(loaded_heap, NULL) : NULL;
+    PointSet* graham_heap = compute_convex_hull(uniform, NULL, NULL);
+    PointSet* monotone_heap = compute_convex_hull_monotone(uniform, NULL, NULL);
+    PointSet* ring = bench_generate_points(BENCH_ON_HULL, 2000, 0, 7);  // One Chan group, sorted on the pool
+    PointSet* chan_heap = compute_convex_hull_chan(uniform, NULL, NULL);
+    PointSet* chan_ring_heap = ring ? compute_convex_hull_chan(ring, NULL, NULL) : NULL;
+    ASSERT_TRUE(loaded_heap && culled_heap && graham_heap && monotone_heap && chan_heap && chan_ring_heap);
+    if (!loaded_heap || !culled_heap || !graham_heap || !monotone_heap || !chan_heap || !chan_ring_heap) return;
+
+    ThreadPool* pool = thread_pool_create(4);
+    thread_pool_set_inline_threshold(pool, 0);  // Exercise the parallel sort's scratch buffers
+    Arena* arena = arena_create(0);
+    size_t mismatches = 0;
+    uint64_t steady_allocations = 0;
+    for (int cycle = 0; cycle < 3; ++cycle) {
+        stats_reset();
+        stats_enable(1);
+        PointSet* loaded = load_points_arena(temp_file, arena);
+        PointSet* culled = loaded ? cull_interior_points(loaded, arena) : NULL;
+        uint64_t heap_before = heap_calls_seen();
+        heap_watch(cycle > 0);  // Loading opens a FILE, so only the hulls are watched
+        PointSet* graham = compute_convex_hull(uniform, pool, arena);
+        PointSet* monotone = compute_convex_hull_monotone(uniform, pool, arena);
+        PointSet* parallel = compute_convex_hull_parallel(uniform, pool, arena);
+        PointSet* chan = compute_convex_hull_chan(uniform, pool, arena);
+        PointSet* chan_ring = compute_convex_hull_chan(ring, pool, arena);
+        heap_watch(0);
+        stats_enable(0);
+        if (cycle > 0) steady_allocations += stats_counter(STATS_ALLOCATIONS) + heap_calls_seen() - heap_before;
+        if (!loaded || loaded->count != loaded_heap->count ||
+            memcmp(loaded->points, loaded_heap->points, loaded->count * sizeof(Point)) != 0) mismatches++;
+        if (!culled || culled->count != culled_heap->count) mismatches++;
+        if (!graham || graham->count != graham_heap->count ||
+            memcmp(graham->points, graham_heap->points, graham->count * sizeof(Point)) != 0) mismatches++;
+        if (!monotone || monotone->count != monotone_heap->count ||
+            memcmp(monotone->points, monotone_heap->points, monotone->count * sizeof(Point)) != 0) mismatches++;
+        if (!parallel || parallel->count != monotone_heap->count ||
+            memcmp(parallel->points, monotone_heap->points, parallel->count * sizeof(Point)) != 0) mismatches++;
+        if (!chan || chan->count != chan_heap->count ||
+            memcmp(chan->points, chan_heap->points, chan->count * sizeof(Point)) != 0) mismatches++;
+        if (!chan_ring || chan_ring->count != chan_ring_heap->count ||
+            memcmp(chan_ring->points, chan_ring_heap->points, chan_ring->count * sizeof(Point)) != 0) mismatches++;
+        arena_reset(arena);
+    }
+    ASSERT_TRUE(mismatches == 0);
+    ASSERT_TRUE(steady_allocations == 0);
+
+    arena_destroy(arena);
+    thread_pool_destroy(pool);
+    stats_reset();
+    free_points(chan_ring_heap);
+    free_points(chan_heap);
+    free_points(ring);
+    free_points(monotone_heap);
+    free_points(graham_heap);
+    free_points(culled_heap);
+    free_points(loaded_heap);
+    free_points(uniform);
+    remove(temp_file);
+}
+
+// Test monotone chain hull (interior and collinear points dropped)
+static void test_convex_hull_monotone() {
+    Point points[] = {{0,0,0}, {2,0,0}, {4,0,0}, {4,4,0}, {0,4,0}, {1,1,0}, {2,3,0}};
+    PointSet set = {points, 7, 0};
+
+    PointSet* hull = compute_convex_hull_monotone(&set, NULL, NULL);
+    ASSERT_TRUE(hull != NULL);
+    if (hull) {
+        ASSERT_TRUE(hull->count == 4);  // Square corners only
+        ASSERT_FLOAT_EQ(16.0f, compute_area(hull), 0.001f);
+    }
+    free_points(hull);
+}
+
+// Test the compact 2D working layout: same hull as the 3D layout, z = 0 out; 3D keeps vertex z
+static void test_convex_hull_layouts() {
+    enum { N = 3000 };
+    Point* flat = malloc(N * sizeof(Point));
+    Point* raised = malloc(N * sizeof(Point));
+    ASSERT_TRUE(flat != NULL && raised != NULL);
+    if (!flat || !raised) {
+        free(flat);
+        free(raised);
+        return;
+    }
+    srand(19);
+    for (size_t i = 0; i < N; ++i) {
+        float x = (float)(rand() % 500), y = (float)(rand() % 500);  // Grid: duplicates and collinear runs
+        flat[i] = (Point){x, y, 0.0f};
+        raised[i] = (Point){x, y, x + 2.0f * y};
+    }
+    PointSet set2 = {flat, N, 0};
+    PointSet set3 = {raised, N, 1};
+    ThreadPool* pool = thread_pool_create(3);
+    thread_pool_set_inline_threshold(pool, 0);  // Merge compact runs on the pool too
+
+    for (int graham = 0; graham <= 1; ++graham) {
+        PointSet* hull2 = graham ? compute_convex_hull(&set2, pool, NULL) : compute_convex_hull_monotone(&set2, pool, NULL);
+        PointSet* hull3 = graham ? compute_convex_hull(&set3, pool, NULL) : compute_convex_hull_monotone(&set3, pool, NULL);
+        ASSERT_TRUE(hull2 != NULL && hull3 != NULL);
+        if (hull2 && hull3) {
+            ASSERT_TRUE(hull2->is_3d == 0 && hull3->is_3d == 1);
+            ASSERT_TRUE(hull2->count == hull3->count && hull2->count >= 3);
+            int same_xy = hull2->count == hull3->count, z_ok = 1;
+            for (size_t i = 0; same_xy && i < hull2->count; ++i) {
+                same_xy = hull2->points[i].x == hull3->points[i].x && hull2->points[i].y == hull3->points[i].y;
+                z_ok &= hull2->points[i].z == 0.0f &&
+                        hull3->points[i].z == hull3->points[i].x + 2.0f * hull3->points[i].y;
+            }
+            ASSERT_TRUE(same_xy);
+            ASSERT_TRUE(z_ok);
+        }
+        free_points(hull2);
+        free_points(hull3);
+    }
+    thread_pool_destroy(pool);
+    free(flat);
+    free(raised);
+}
+
+// Test the hull of per-thread hulls matches the serial monotone chain, with and without z
+static void test_convex_hull_parallel() {
+    enum { N = 20000 };
+    Point* points = malloc(N * sizeof(Point));
+    ASSERT_TRUE(points != NULL);
+    if (!points) return;
+    srand(21);
+    for (size_t i = 0; i < N; ++i) {
+        float x = (float)(rand() % 1000), y = (float)(rand() % 1000);  // Duplicates and collinear edges
+        points[i] = (Point){x, y, x - y};
+    }
+    ThreadPool* pool = thread_pool_create(3);
+    for (int is_3d = 0; is_3d <= 1; ++is_3d) {
+        PointSet set = {points, N, is_3d};
+        thread_pool_set_inline_threshold(pool, 0);
+        PointSet* parallel = compute_convex_hull_parallel(&set, pool, NULL);
+        PointSet* serial = compute_convex_hull_monotone(&set, NULL, NULL);
+        ASSERT_TRUE(parallel != NULL && serial != NULL);
+        if (parallel && serial) {
+            ASSERT_TRUE(parallel->count == serial->count && parallel->is_3d == is_3d);
+            int same = parallel->count == serial->count;
+            for (size_t i = 0; same && i < serial->count; ++i) {
+                same = memcmp(&parallel->points[i], &serial->points[i], sizeof(Point)) == 0;
+            }
+            ASSERT_TRUE(same);
+        }
+        free_points(parallel);
+        free_points(serial);
+    }
+
+    PointSet small = {points, 7, 0};  // Too few points to split: plain monotone chain
+    PointSet* hull = compute_convex_hull_parallel(&small, pool, NULL);
+    ASSERT_TRUE(hull != NULL && hull->count >= 3);
+    free_points(hull);
+    thread_pool_destroy(pool);
+    free(points);
+}
+
+// Helper: Non-zero if a lists the same vertices as b in the same cyclic order
+static int same_cycle(const PointSet* a, const PointSet* b) {
+    if (a->count != b->count || a->count == 0) return 0;
+    size_t shift = 0;
+    while (shift < a->count && memcmp(&a->points[shift], &b->points[0], sizeof(Point)) != 0) ++shift;
+    if (shift == a->count) return 0;
+    for (size_t i = 0; i < b->count; ++i) {
+        if (memcmp(&a->points[(shift + i) % a->count], &b->points[i], sizeof(Point)) != 0) return 0;
+    }
+    return 1;
+}
+
+// Test Chan's hull matches the monotone chain for small and large h, serial and pooled
+static void test_convex_hull_chan() {
+    enum { N = 20000 };
+    Point* points = malloc(N * sizeof(Point));
+    ASSERT_TRUE(points != NULL);
+    if (!points) return;
+    ThreadPool* pool = thread_pool_create(3);
+    thread_pool_set_inline_threshold(pool, 0);
+    srand(22);
+    for (int shape = 0; shape < 2; ++shape) {
+        for (size_t i = 0; i < N; ++i) {
+            float x, y;
+            if (shape == 0) {
+                x = (float)(rand() % 1000);  // Duplicates and collinear edges, small h
+                y = (float)(rand() % 1000);
+            } else {
+                double angle = (double)rand() / RAND_MAX * 6.283185307179586;  // Thousands of hull points: several rounds
+                x = (float)(1000.0 * cos(angle));
+                y = (float)(1000.0 * sin(angle));
+            }
+            points[i] = (Point){x, y, x - y};
+        }
+        for (int is_3d = 0; is_3d <= 1; ++is_3d) {
+            PointSet set = {points, N, is_3d};
+            PointSet* serial = compute_convex_hull_monotone(&set, NULL, NULL);
+            for (int use_pool = 0; use_pool <= 1; ++use_pool) {
+                PointSet* chan = compute_convex_hull_chan(&set, use_pool ? pool : NULL, NULL);
+                ASSERT_TRUE(chan != NULL && serial != NULL);
+                if (chan && serial) {
+                    ASSERT_TRUE(same_cycle(chan, serial) && chan->is_3d == is_3d);
+                    ASSERT_TRUE(compute_area(chan) > 0.0f);  // Counterclockwise
+                }
+                free_points(chan);
+            }
+            free_points(serial);
+        }
+    }
+
+    for (size_t i = 0; i < 100; ++i) points[i] = (Point){(float)(i % 10), (float)(i % 10) * 2.0f, 0.0f};
+    PointSet line = {points, 100, 0};  // Collinear: both end points only
+    PointSet* hull = compute_convex_hull_chan(&line, pool, NULL);
+    ASSERT_TRUE(hull != NULL && hull->count == 2);
+    free_points(hull);
+
+    for (size_t i = 0; i < 100; ++i) points[i] = (Point){4.0f, -2.0f, (float)i};
+    for (int is_3d = 0; is_3d <= 1; ++is_3d) {
+        PointSet same = {points, 100, is_3d};  // All duplicates: 2 points, as the monotone chain gives
+        PointSet* chan = compute_convex_hull_chan(&same, pool, NULL);
+        PointSet* serial = compute_convex_hull_monotone(&same, NULL, NULL);
+        ASSERT_TRUE(chan != NULL && serial != NULL);
+        if (chan && serial) {
+            ASSERT_TRUE(chan->count == 2 && serial->count == 2);
+            ASSERT_TRUE(chan->count == serial->count &&
+                        memcmp(chan->points, serial->points, serial->count * sizeof(Point)) == 0);
+        }
+        free_points(chan);
+        free_points(serial);
+    }
+    thread_pool_destroy(pool);
+    free(points);
+}
+
+// Test the Graham key sort where keys tie or round: points on shared rays from the pivot, and
+// UTM-scale points whose angles differ by less than the key resolution
+static void test_convex_hull_graham_keys() {
+    enum { N = 6000 };
+    Point* points = malloc(N * sizeof(Point));
+    ASSERT_TRUE(points != NULL);
+    if (!points) return;
+    ThreadPool* pool = thread_pool_create(3);
+    thread_pool_set_inline_threshold(pool, 0);
+    srand(23);
+    for (int shape = 0; shape < 2; ++shape) {
+        for (size_t i = 0; i < N; ++i) {
+            if (shape == 0) {
+                float step = (float)(1 + rand() % 50);  // 12 rays from (0, 0), many points per ray
+                int ray = rand() % 12;
+                points[i] = (Point){step * (float)(ray - 6), step * (float)(1 + ray % 5), 0.0f};
+            } else {
+                points[i] = (Point){500000.0f + (float)(rand() % 2000) * 0.0625f,
+                                    5000000.0f + (float)(rand() % 4) * 0.5f, 0.0f};
+            }
+        }
+        if (shape == 0) points[N / 2] = (Point){0.0f, 0.0f, 0.0f};  // Pivot in the middle of the input
+        PointSet set = {points, N, 0};
+        PointSet* monotone = compute_convex_hull_monotone(&set, NULL, NULL);
+        for (int use_pool = 0; use_pool <= 1; ++use_pool) {
+            PointSet* graham = compute_convex_hull(&set, use_pool ? pool : NULL, NULL);
+            ASSERT_TRUE(graham != NULL && monotone != NULL);
+            if (graham && monotone) ASSERT_TRUE(same_cycle(graham, monotone));
+            free_points(graham);
+        }
+        free_points(monotone);
+    }
+    thread_pool_destroy(pool);
+    free(points);
+}
+
+// Test the index hull names the monotone hull's vertices, lowest index first among duplicates,
+// on the heap and in an arena
+static void test_convex_hull_indices() {
+    enum { N = 20000 };
+    Point* points = malloc(N * sizeof(Point));
+    ASSERT_TRUE(points != NULL);
+    if (!points) return;
+    srand(24);
+    for (size_t i = 0; i < N; ++i) {
+        points[i] = (Point){(float)(rand() % 500), (float)(rand() % 500), (float)i};  // Duplicates
+    }
+    ThreadPool* pool = thread_pool_create(3);
+    thread_pool_set_inline_threshold(pool, 0);
+    Arena* arena = arena_create(0);
+    PointSet set = {points, N, 1};
+    PointSet* reference = compute_convex_hull_monotone(&set, NULL, NULL);
+    for (int run = 0; run < 3; ++run) {
+        HullIndices* hull = compute_convex_hull_indices(&set, run == 1 ? pool : NULL, run == 2 ? arena : NULL);
+        ASSERT_TRUE(hull != NULL && reference != NULL);
+        if (hull && reference) {
+            ASSERT_TRUE(hull->count == reference->count);
+            int same = hull->count == reference->count;
+            for (size_t i = 0; same && i < hull->count; ++i) {
+                const Point* p = &points[hull->indices[i]];
+                same = hull->indices[i] < N && p->x == reference->points[i].x && p->y == reference->points[i].y;
+                for (uint32_t j = 0; same && j < hull->indices[i]; ++j) {
+                    same = points[j].x != p->x || points[j].y != p->y;  // No earlier duplicate
+                }
+            }
+            ASSERT_TRUE(same);
+        }
+        if (run != 2) free_hull_indices(hull);
+    }
+    free_points(reference);
+    PointSet small = {points, 2, 0};
+    ASSERT_TRUE(compute_convex_hull_indices(&small, NULL, NULL) == NULL);
+
+    // Pooled index sorts (4-byte elements through the parallel merge) match the serial one
+    enum { LARGE = 200000 };
+    Point* large = malloc(LARGE * sizeof(Point));
+    ASSERT_TRUE(large != NULL);
+    ThreadPool* wide_pool = thread_pool_create(8);
+    thread_pool_set_inline_threshold(wide_pool, 0);
+    for (int rep = 0; large && rep < 5; ++rep) {
+        for (size_t i = 0; i < LARGE; ++i) {
+            large[i] = (Point){(float)rand() / RAND_MAX * 1000.0f, (float)rand() / RAND_MAX * 1000.0f, 0.0f};
+        }
+        PointSet big = {large, LARGE, 0};
+        HullIndices* serial = compute_convex_hull_indices(&big, NULL, NULL);
+        HullIndices* pooled = compute_convex_hull_indices(&big, wide_pool, NULL);
+        ASSERT_TRUE(serial != NULL && pooled != NULL);
+        if (serial && pooled) {
+            ASSERT_TRUE(pooled->count == serial->count &&
+                        memcmp(pooled->indices, serial->indices, serial->count * sizeof(uint32_t)) == 0);
+        }
+        free_hull_indices(serial);
+        free_hull_indices(pooled);
+    }
+    thread_pool_destroy(wide_pool);
+    free(large);
+    arena_destroy(arena);
+    thread_pool_destroy(pool);
+    free(points);
+}
+
+// Test the caller-buffer hull matches the monotone chain on both sort paths, reports the size
+// it needs when out is short, rejects short scratch, and allocates nothing
+static void test_convex_hull_into() {
+    enum { N = 5000 };
+    Point* points = malloc(N * sizeof(Point));
+    Point* out = malloc((N + 1) * sizeof(Point));
+    void* scratch = malloc(convex_hull_scratch_bytes(N, 1));
+    ASSERT_TRUE(points != NULL && out != NULL && scratch != NULL);
+    if (!points || !out || !scratch) {
+        free(points);
+        free(out);
+        free(scratch);
+        return;
+    }
+    srand(25);
+    for (size_t i = 0; i < N; ++i) {
+        float x = (float)(rand() % 2001 - 1000) * 0.5f, y = (float)(rand() % 2001 - 1000) * 0.5f;  // Signs, zeros
+        points[i] = (Point){x, y, (float)(rand() % 10)};
+    }
+    size_t sizes[2] = {40, N};  // Insertion sort, radix sort
+    for (int s = 0; s < 2; ++s) {
+        for (int is_3d = 0; is_3d <= 1; ++is_3d) {
+            PointSet set = {points, sizes[s], is_3d};
+            PointSet* reference = compute_convex_hull_monotone(&set, NULL, NULL);
+            stats_enable(1);
+            stats_reset();
+            long count = compute_convex_hull_into(&set, scratch, convex_hull_scratch_bytes(sizes[s], is_3d), out,
+                                                  N + 1);
+            ASSERT_TRUE(stats_counter(STATS_ALLOCATIONS) == 0);
+            stats_enable(0);
+            ASSERT_TRUE(reference != NULL && count == (long)reference->count);
+            int same = reference && count == (long)reference->count;
+            for (long i = 0; same && i < count; ++i) {
+                same = out[i].x == reference->points[i].x && out[i].y == reference->points[i].y &&
+                       (is_3d || out[i].z == 0.0f);
+            }
+            ASSERT_TRUE(same);
+            free_points(reference);
+        }
+    }
+
+    PointSet set = {points, N, 0};
+    long count = compute_convex_hull_into(&set, scratch, convex_hull_scratch_bytes(N, 0), out, N + 1);
+    out[2] = (Point){-1.0f, -1.0f, -1.0f};  // Sentinel past a short capacity
+    ASSERT_TRUE(compute_convex_hull_into(&set, scratch, convex_hull_scratch_bytes(N, 0), out, 2) == count);
+    ASSERT_TRUE(out[2].x == -1.0f && out[2].y == -1.0f);
+    ASSERT_TRUE(compute_convex_hull_into(&set, scratch, convex_hull_scratch_bytes(N, 0), NULL, 0) == count);
+    ASSERT_TRUE(compute_convex_hull_into(&set, scratch, convex_hull_scratch_bytes(N, 0) - 1, out, N + 1) == -1);
+    free(points);
+    free(out);
+    free(scratch);
+}
+
+typedef struct {
+    PointSet set;
+    PointSet* hull;
+    ThreadPool* pool;
+    int graham;
+} HullJob;
+
+static void* hull_worker(void* arg) {
+    HullJob* job = (HullJob*)arg;
+    job->hull = job->graham ? compute_convex_hull(&job->set, job->pool, NULL)
+                            : compute_convex_hull_monotone(&job->set, job->pool, NULL);
+    return NULL;
+}
+
+// Test both hulls are reentrant: concurrent calls, serial or sharing one pool, match serial results
+static void test_convex_hull_concurrent(int graham, int use_pool) {
+    enum { JOBS = 4, N = 2000 };
+    HullJob jobs[JOBS];
+    pthread_t threads[JOBS];
+    ThreadPool* pool = use_pool ? thread_pool_create(3) : NULL;
+    thread_pool_set_inline_threshold(pool, 0);  // Split even these small sorts
+    srand(7);
+    for (int j = 0; j < JOBS; ++j) {
+        jobs[j].pool = pool;
+        jobs[j].graham = graham;
+        jobs[j].set.points = malloc(N * sizeof(Point));
+        jobs[j].set.count = N;
+        jobs[j].set.is_3d = 0;
+        for (size_t i = 0; i < N; ++i) {
+            jobs[j].set.points[i].x = (float)rand() / RAND_MAX * 100.0f * (j + 1);
+            jobs[j].set.points[i].y = (float)rand() / RAND_MAX * 100.0f;
+            jobs[j].set.points[i].z = 0.0f;
+        }
+    }
+    for (int j = 0; j < JOBS; ++j) pthread_create(&threads[j], NULL, hull_worker, &jobs[j]);
+    for (int j = 0; j < JOBS; ++j) pthread_join(threads[j], NULL);
+    thread_pool_destroy(pool);
+
+    for (int j = 0; j < JOBS; ++j) {
+        PointSet* serial = graham ? compute_convex_hull_monotone(&jobs[j].set, NULL, NULL)
+                                  : compute_convex_hull(&jobs[j].set, NULL, NULL);
+        ASSERT_TRUE(jobs[j].hull != NULL && serial != NULL);
+        if (jobs[j].hull && serial) {
+            ASSERT_TRUE(jobs[j].hull->count == serial->count);
+            ASSERT_FLOAT_EQ(compute_area(serial), compute_area(jobs[j].hull), 0.01f);
+        }
+        free_points(serial);
+        free_points(jobs[j].hull);
+        free(jobs[j].set.points);
+    }
+}
+
+// Test grid snapping: exact round trip on the grid, word width picked by extent, bad steps rejected
+static void test_quantize() {
+    Point points[] = {{500000.125f, 4000000.5f, 1.5f}, {500010.0f, 4000001.0f, -2.0f}, {499990.25f, 4000000.0f, 0.0f}};
+    PointSet set = {points, 3, 1};
+
+    QuantizedSet* q = quantize_points(&set, 0.125, NULL);
+    ASSERT_TRUE(q != NULL);
+    if (q) {
+        ASSERT_TRUE(q->key_words == 1 && q->stride == 2 && q->count == 3);
+        ASSERT_TRUE(q->origin_x == 3999922 && q->origin_y == 32000000);  // Lowest cells
+        PointSet* back = dequantize_points(q, NULL);
+        ASSERT_TRUE(back != NULL && back->is_3d == 1);
+        if (back) ASSERT_TRUE(memcmp(back->points, points, sizeof(points)) == 0);
+        free_points(back);
+    }
+    free_quantized(q);
+
+    set.is_3d = 0;
+    q = quantize_points(&set, 1e-9, NULL);  // 2e10 cells across: two words
+    ASSERT_TRUE(q != NULL);
+    if (q) {
+        ASSERT_TRUE(q->key_words == 2 && q->stride == 2);
+        PointSet* back = dequantize_points(q, NULL);
+        ASSERT_TRUE(back != NULL);
+        if (back) {
+            ASSERT_FLOAT_EQ(500000.125f, back->points[0].x, 0.0f);
+            ASSERT_FLOAT_EQ(4000000.0f, back->points[2].y, 0.0f);
+            ASSERT_FLOAT_EQ(0.0f, back->points[0].z, 0.0f);
+        }
+        free_points(back);
+    }
+    free_quantized(q);
+
+    ASSERT_TRUE(quantize_points(&set, 1e-14, NULL) == NULL);  // Beyond 2^62 cells
+    ASSERT_TRUE(quantize_points(&set, 0.0, NULL) == NULL);
+    ASSERT_TRUE(quantize_points(&set, -1.0, NULL) == NULL);
+}
+
+// Test the radix sort: ascending by the key words, stable for equal keys, payload carried along,
+// serial and split over a pool
+static void test_radix_sort() {
+    enum { N = 5000 };
+    uint64_t* elems = malloc(N * 3 * sizeof(uint64_t));
+    uint64_t* scratch = malloc(N * 3 * sizeof(uint64_t));
+    ASSERT_TRUE(elems != NULL && scratch != NULL);
+    if (!elems || !scratch) {
+        free(elems);
+        free(scratch);
+        return;
+    }
+    ThreadPool* pool = thread_pool_create(3);
+    thread_pool_set_inline_threshold(pool, 0);
+    srand(20);
+    for (int use_pool = 0; use_pool <= 1; ++use_pool) {
+        for (size_t i = 0; i < N; ++i) {
+            elems[3 * i] = (uint64_t)(rand() % 40) << 40;  // Few distinct high words: many ties
+            elems[3 * i + 1] = (uint64_t)rand() << 20 | (uint64_t)(rand() % 8);
+            elems[3 * i + 2] = i;  // Input position
+        }
+        radix_sort_words(elems, scratch, N, 3, 2, use_pool ? pool : NULL, NULL);
+        int ordered = 1;
+        for (size_t i = 1; i < N; ++i) {
+            const uint64_t* a = elems + 3 * (i - 1);
+            const uint64_t* b = elems + 3 * i;
+            int less = a[0] < b[0] || (a[0] == b[0] && a[1] < b[1]);
+            int tie_stable = a[0] == b[0] && a[1] == b[1] && a[2] < b[2];
+            ordered &= less || tie_stable;
+        }
+        ASSERT_TRUE(ordered);
+
+        for (size_t i = 0; i < N; ++i) {
+            elems[2 * i] = (uint64_t)(rand() % 16);  // Only the lowest byte varies
+            elems[2 * i + 1] = i;
+        }
+        radix_sort_words(elems, scratch, N, 2, 1, use_pool ? pool : NULL, NULL);
+        ordered = 1;
+        for (size_t i = 1; i < N; ++i) {
+            ordered &= elems[2 * (i - 1)] < elems[2 * i] ||
+                       (elems[2 * (i - 1)] == elems[2 * i] && elems[2 * i - 1] < elems[2 * i + 1]);
+        }
+        ASSERT_TRUE(ordered);
+    }
+    thread_pool_destroy(pool);
+    free(elems);
+    free(scratch);
+}
+
+// Test the grid hull matches the float monotone chain on grid-aligned input, in 2D and 3D
+static void test_convex_hull_grid() {
+    enum { N = 4000 };
+    Point* points = malloc(N * sizeof(Point));
+    ASSERT_TRUE(points != NULL);
+    if (!points) return;
+    srand(21);
+    for (size_t i = 0; i < N; ++i) {
+        float x = 700000.0f + (float)(rand() % 800) * 0.25f, y = 5000000.0f + (float)(rand() % 800) * 0.5f;
+        points[i] = (Point){x, y, (float)(rand() % 100)};
+    }
+    for (int is_3d = 0; is_3d <= 1; ++is_3d) {
+        PointSet set = {points, N, is_3d};
+        Arena* arena = arena_create(0);
+        PointSet* grid = compute_convex_hull_grid(&set, 0.25, arena);
+        PointSet* exact = compute_convex_hull_monotone(&set, NULL, NULL);
+        ASSERT_TRUE(grid != NULL && exact != NULL);
+        if (grid && exact) {
+            ASSERT_TRUE(grid->is_3d == is_3d);
+            ASSERT_TRUE(grid->count == exact->count);
+            int same = grid->count == exact->count, z_ok = 1;
+            for (size_t i = 0; same && i < grid->count; ++i) {
+                same = grid->points[i].x == exact->points[i].x && grid->points[i].y == exact->points[i].y;
+                int found = 0;  // z must belong to an input point at this position
+                for (size_t j = 0; j < N && !found; ++j) {
+                    found = points[j].x == grid->points[i].x && points[j].y == grid->points[i].y &&
+                            (is_3d ? points[j].z == grid->points[i].z : grid->points[i].z == 0.0f);
+                }
+                z_ok &= found;
+            }
+            ASSERT_TRUE(same);
+            ASSERT_TRUE(z_ok);
+        }
+        free_points(exact);
+        arena_destroy(arena);
+    }
+
+    PointSet tiny = {points, 2, 0};
+    ASSERT_TRUE(compute_convex_hull_grid(&tiny, 0.25, NULL) == NULL);
+    free(points);
+}
+
+// Test interior culling keeps every hull vertex and drops interior points
+static void test_cull_interior() {
+    size_t n = 4000;
+    Point* points = malloc(n * sizeof(Point));
+    srand(11);
+    for (size_t i = 0; i < n; ++i) {
+        points[i].x = 500000.0f + (float)rand() / RAND_MAX * 100.0f;  // Large survey-like coordinates
+        points[i].y = (float)rand() / RAND_MAX * 100.0f;
+        points[i].z = 0.0f;
+    }
+    PointSet set = {points, n, 0};
+
+    PointSet* culled = cull_interior_points(&set, NULL);
+    ASSERT_TRUE(culled != NULL);
+    if (culled) {
+        ASSERT_TRUE(culled->count < n / 2);  // Uniform square: most points are interior
+        PointSet* full = compute_convex_hull_monotone(&set, NULL, NULL);
+        PointSet* reduced = compute_convex_hull_monotone(culled, NULL, NULL);
+        ASSERT_TRUE(full != NULL && reduced != NULL);
+        if (full && reduced) {
+            ASSERT_TRUE(full->count == reduced->count);
+            ASSERT_TRUE(memcmp(full->points, reduced->points, full->count * sizeof(Point)) == 0);
+        }
+        free_points(full);
+        free_points(reduced);
+    }
+    free_points(culled);
+    free(points);
+}
+
+// Test streaming hull with tiny blocks matches the in-memory hull
+static void test_convex_hull_stream() {
+    const char* temp_file = "test_stream.csv";
+    size_t n = 3000;
+    Point* points = malloc(n * sizeof(Point));
+    srand(21);
+    for (size_t i = 0; i < n; ++i) {
+        points[i].x = (float)(rand() % 5000) / 8.0f;
+        points[i].y = (float)(rand() % 5000) / 8.0f;
+        points[i].z = 0.0f;
+    }
+    PointSet set = {points, n, 0};
+    ASSERT_TRUE(save_points(&set, temp_file, 3) == 0);
+
+    PointReader* reader = point_reader_open(temp_file);
+    ASSERT_TRUE(reader != NULL);
+    if (reader) {
+        size_t total = 0;
+        PointSet* streamed = compute_convex_hull_stream(reader, 64, NULL, &total);
+        PointSet* full = compute_convex_hull_monotone(&set, NULL, NULL);
+        ASSERT_TRUE(total == n);
+        ASSERT_TRUE(streamed != NULL && full != NULL);
+        if (streamed && full) {
+            ASSERT_TRUE(streamed->count == full->count);
+            ASSERT_TRUE(memcmp(streamed->points, full->points, full->count * sizeof(Point)) == 0);
+        }
+        free_points(streamed);
+        free_points(full);
+        point_reader_close(reader);
+    }
+    free(points);
+    remove(temp_file);
+}
+
+// Test 3D quickhull on a cube with interior and face points: 8 vertices, 12 triangles
+static void test_convex_hull_3d_cube() {
+    Point points[] = {{0,0,0}, {2,0,0}, {0,2,0}, {2,2,0}, {0,0,2}, {2,0,2}, {0,2,2}, {2,2,2},
+                      {1,1,1}, {0.5f,1.5f,0.5f}, {1,1,0}, {2,1,1}};  // Interior, then on faces
+    PointSet set = {points, 12, 1};
+
+    HullMesh* mesh = compute_convex_hull_3d(&set, NULL);
+    ASSERT_TRUE(mesh != NULL);
+    if (mesh) {
+        ASSERT_TRUE(mesh->vertex_count == 8);
+        ASSERT_TRUE(mesh->face_count == 12);
+        ASSERT_FLOAT_EQ(24.0f, compute_surface_area(mesh), 0.001f);
+        ASSERT_FLOAT_EQ(8.0f, compute_volume(mesh), 0.001f);
+    }
+    free_mesh(mesh);
+
+    // Coplanar input has no 3D hull
+    Point flat[] = {{0,0,0}, {1,0,0}, {0,1,0}, {1,1,0}};
+    PointSet flat_set = {flat, 4, 0};
+    ASSERT_TRUE(compute_convex_hull_3d(&flat_set, NULL) == NULL);
+}
+
+// Test 3D quickhull on a random sphere: every point on or under every face, closed surface
+static void test_convex_hull_3d_sphere() {
+    size_t n = 40000;  // Large enough for the parallel assignment path
+    Point* points = malloc(n * sizeof(Point));
+    srand(5);
+    for (size_t i = 0; i < n; ++i) {
+        float x, y, z, r;
+        do {
+            x = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+            y = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+            z = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+            r = x * x + y * y + z * z;
+        } while (r < 0.01f || r > 1.0f);
+        r = sqrtf(r);
+        float scale = (i % 4 == 0) ? 0.5f : 1.0f;  // Some interior points
+        points[i].x = 100.0f + x / r * 10.0f * scale;
+        points[i].y = y / r * 10.0f * scale;
+        points[i].z = z / r * 10.0f * scale;
+    }
+    PointSet set = {points, n, 1};
+
+    ThreadPool* pool = thread_pool_create(4);
+    HullMesh* mesh = compute_convex_hull_3d(&set, pool);
+    thread_pool_destroy(pool);
+    ASSERT_TRUE(mesh != NULL);
+    if (mesh) {
+        // Euler characteristic of a closed triangulated sphere: F = 2V - 4
+        ASSERT_TRUE(mesh->face_count == 2 * mesh->vertex_count - 4);
+        float volume = compute_volume(mesh);
+        ASSERT_TRUE(volume > 4000.0f && volume < 4188.8f);  // Below the 4/3*pi*1000 sphere
+        size_t outside = 0;
+        for (size_t f = 0; f < mesh->face_count; ++f) {
+            const Point* a = &mesh->vertices[mesh->faces[3 * f]];
+            const Point* b = &mesh->vertices[mesh->faces[3 * f + 1]];
+            const Point* c = &mesh->vertices[mesh->faces[3 * f + 2]];
+            double ux = b->x - a->x, uy = b->y - a->y, uz = b->z - a->z;
+            double wx = c->x - a->x, wy = c->y - a->y, wz = c->z - a->z;
+            double nx = uy * wz - uz * wy, ny = uz * wx - ux * wz, nz = ux * wy - uy * wx;
+            for (size_t i = 0; i < n; i += 97) {
+                double d = nx * (points[i].x - a->x) + ny * (points[i].y - a->y) + nz * (points[i].z - a->z);
+                if (d > 1e-6) outside++;
+            }
+        }
+        ASSERT_TRUE(outside == 0);
+    }
+    free_mesh(mesh);
+    free(points);
+}
+
+// Test SoA conversion round trip, alignment and 2D storage
+static void test_soa_roundtrip() {
+    Point points[] = {{1.5f,2.5f,3.5f}, {-4,5,6}, {7,-8,9}};
+    PointSet set = {points, 3, 1};
+
+    PointSetSoA* soa = points_to_soa(&set);
+    ASSERT_TRUE(soa != NULL);
+    if (soa) {
+        ASSERT_TRUE(((size_t)soa->x % SOA_ALIGNMENT) == 0 && ((size_t)soa->y % SOA_ALIGNMENT) == 0);
+        ASSERT_TRUE(soa->z != NULL && soa->count == 3);
+        PointSet* back = soa_to_points(soa);
+        ASSERT_TRUE(back != NULL && back->is_3d == 1);
+        if (back) ASSERT_TRUE(memcmp(back->points, points, sizeof(points)) == 0);
+        free_points(back);
+    }
+    free_points_soa(soa);
+
+    set.is_3d = 0;
+    soa = points_to_soa(&set);
+    ASSERT_TRUE(soa != NULL && soa->z == NULL);  // 2D sets carry no z array
+    if (soa) {
+        PointSet* back = soa_to_points(soa);
+        ASSERT_TRUE(back != NULL);
+        if (back) ASSERT_TRUE(back->points[1].x == -4.0f && back->points[1].z == 0.0f);
+        free_points(back);
+    }
+    free_points_soa(soa);
+}
+
+// Test SoA kernels agree exactly with the AoS versions
+static void test_soa_kernels() {
+    size_t n = 5000;
+    Point* points = malloc(n * sizeof(Point));
+    srand(13);
+    for (size_t i = 0; i < n; ++i) {
+        points[i].x = (float)rand() / RAND_MAX * 100.0f;
+        points[i].y = (float)(rand() % 200) / 2.0f;  // Repeated y values exercise pivot ties
+        points[i].z = 0.0f;
+    }
+    PointSet set = {points, n, 0};
+    PointSetSoA* soa = points_to_soa(&set);
+    ASSERT_TRUE(soa != NULL);
+    if (soa) {
+        ASSERT_TRUE(compute_area_soa(soa) == compute_area(&set));
+        ASSERT_TRUE(compute_path_length_soa(soa) == compute_path_length(&set));
+
+        size_t pivot_idx = find_pivot_soa(soa);
+        size_t below = 0;
+        for (size_t i = 0; i < n; ++i) {
+            below += points[i].y < points[pivot_idx].y ||
+                     (points[i].y == points[pivot_idx].y && points[i].x < points[pivot_idx].x);
+        }
+        ASSERT_TRUE(below == 0);
+
+        PointSet* culled = cull_interior_points(&set, NULL);
+        PointSetSoA* culled_soa = cull_interior_points_soa(soa);
+        ASSERT_TRUE(culled != NULL && culled_soa != NULL);
+        if (culled && culled_soa) {
+            ASSERT_TRUE(culled->count == culled_soa->count);
+            PointSet* back = soa_to_points(culled_soa);
+            if (back) ASSERT_TRUE(memcmp(back->points, culled->points, culled->count * sizeof(Point)) == 0);
+            free_points(back);
+        }
+        free_points(culled);
+        free_points_soa(culled_soa);
+    }
+    free_points_soa(soa);
+    free(points);
+}
+
+// Test every supported SIMD level against the scalar kernels, across tail lengths
+static void test_simd_kernels() {
+    size_t max_n = 1000;
+    Point* points = malloc(max_n * sizeof(Point));
+    srand(17);
+    for (size_t i = 0; i < max_n; ++i) {
+        points[i].x = (float)rand() / RAND_MAX * 100.0f;
+        points[i].y = (float)rand() / RAND_MAX * 100.0f;
+        points[i].z = (float)rand() / RAND_MAX * 100.0f;
+    }
+    size_t sizes[] = {1, 2, 3, 4, 5, 8, 9, 16, 17, 23, 1000};
+    SimdLevel best = simd_detect_level();
+    size_t mismatches = 0;
+    for (int level = SIMD_SCALAR; level <= (int)best; ++level) {
+        for (size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); ++s) {
+            size_t n = sizes[s];
+            PointSet set = {points, n, 1};
+            PointSetSoA* soa = points_to_soa(&set);
+            if (!soa) continue;
+
+            simd_set_level(SIMD_SCALAR);
+            float area_ref = simd_shoelace_aos(points, n);
+            float length_ref = simd_path_length_aos(points, n);
+            simd_set_level((SimdLevel)level);
+            float area = simd_shoelace_aos(points, n);
+            float length = simd_path_length_aos(points, n);
+            mismatches += fabsf(area - area_ref) > 1e-5f * (n * 10000.0f);
+            mismatches += fabsf(length - length_ref) > 1e-5f * length_ref;
+            // SoA and AoS share lane layout and reduction order at every level
+            mismatches += simd_shoelace_soa(soa->x, soa->y, n) != area;
+            mismatches += simd_path_length_soa(soa->x, soa->y, soa->z, n) != length;
+            free_points_soa(soa);
+        }
+    }
+    ASSERT_TRUE(mismatches == 0);
+    ASSERT_TRUE(simd_set_level(SIMD_AVX2) == best);  // Clamped to the CPU
+    free(points);
+}
+
+// Test double-precision accumulation on a finely subdivided square at UTM-sized coordinates
+static void test_accum_modes() {
+    size_t per_side = 1001;  // Odd count leaves ragged vector blocks
+    size_t n = 4 * per_side;
+    Point* points = malloc(n * sizeof(Point));
+    float x0 = 500000.0f, y0 = 5000000.0f;
+    for (size_t i = 0; i < per_side; ++i) {
+        float t = 10.0f * (float)i / per_side;
+        points[i] = (Point){x0 + t, y0, 0.0f};
+        points[per_side + i] = (Point){x0 + 10.0f, y0 + t, 0.0f};
+        points[2 * per_side + i] = (Point){x0 + 10.0f - t, y0 + 10.0f, 0.0f};
+        points[3 * per_side + i] = (Point){x0, y0 + 10.0f - t, 0.0f};
+    }
+    PointSet set = {points, n, 0};
+    PointSetSoA* soa = points_to_soa(&set);
+    ASSERT_TRUE(soa != NULL);
+
+    ASSERT_TRUE(compute_area_accum(&set, ACCUM_FLOAT) == compute_area(&set));
+    SimdLevel best = simd_detect_level();
+    size_t mismatches = 0;
+    for (int level = SIMD_SCALAR; level <= (int)best; ++level) {
+        simd_set_level((SimdLevel)level);
+        for (int mode = ACCUM_DOUBLE; mode <= ACCUM_PAIRWISE; ++mode) {
+            double area = compute_area_accum(&set, (AccumMode)mode);
+            double length = compute_path_length_accum(&set, (AccumMode)mode);
+            mismatches += fabs(area - 100.0) > 1e-9;  // Rounded vertices stay on the square's edges
+            mismatches += fabs(length - 40.0) > 1e-9;
+            if (soa) {
+                mismatches += compute_area_soa_accum(soa, (AccumMode)mode) != area;
+                mismatches += compute_path_length_soa_accum(soa, (AccumMode)mode) != length;
+            }
+        }
+    }
+    simd_set_level(best);
+    ASSERT_TRUE(mismatches == 0);
+    ASSERT_TRUE(compute_area_accum(NULL, ACCUM_KAHAN) < 0);
+
+    free_points_soa(soa);
+    free(points);
+}
+
+// Test area
+static void test_area() {
+    Point points[] = {{0,0,0}, {3,0,0}, {0,4,0}};
+    PointSet hull = {points, 3, 0};
+    ASSERT_FLOAT_EQ(6.0f, compute_area(&hull), 0.001f);  // (3*4)/2 = 6
+}
+
+// Test path length (perimeter)
+static void test_path_length() {
+    Point points[] = {{0,0,0}, {3,0,0}, {0,4,0}};
+    PointSet hull = {points, 3, 0};
+    float expected = 3 + 5 + 4;  // Sides: 3, sqrt(9+16)=5, 4
+    ASSERT_FLOAT_EQ(expected, compute_path_length(&hull), 0.001f);
+}
+
+// Run all tests
+void run_all_tests() {
+    test_io();
+    test_load_mmap();
+    test_load_mmap_hex();
+    test_load_mmap_threads();
+    test_load_points_into();
+    test_save_format();
+    test_binary_roundtrip();
+    test_distance();
+    test_collinear();
+    test_orient2d();
+    test_convex_hull_large_coordinates();
+    test_convex_hull_simple();
+    test_convex_hull_with_internal();
+    test_convex_hull_edge();
+    test_thread_pool();
+    test_bench_summary();
+    test_bench_distributions();
+    test_stats_counters();
+    test_arena();
+    test_arena_steady_state();
+    test_convex_hull_threads();
+    test_convex_hull_monotone();
+    test_convex_hull_layouts();
+    test_convex_hull_parallel();
+    test_convex_hull_chan();
+    test_convex_hull_graham_keys();
+    test_convex_hull_indices();
+    test_convex_hull_into();
+    test_convex_hull_concurrent(0, 1);
+    test_convex_hull_concurrent(1, 0);
+    test_convex_hull_concurrent(1, 1);
+    test_quantize();
+    test_radix_sort();
+    test_convex_hull_grid();
+    test_cull_interior();
+    test_convex_hull_stream();
+    test_convex_hull_3d_cube();
+    test_convex_hull_3d_sphere();
+    test_soa_roundtrip();
+    test_soa_kernels();
+    test_simd_kernels();
+    test_accum_modes();
+    test_area();
+    test_path_length();
+}
+
+int get_tests_run() { return tests_run; }
 int get_tests_failed() { return tests_failed; }
\ No newline at end of file